@@ -0,0 +1,54 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "acars_format.hpp"
+
+#include "string_format.hpp"
+
+namespace acars {
+namespace format {
+
+static void append_field(StringBuffer& out, const Packet& packet, const Packet::Field field) {
+	for(size_t i=field.start; i<(field.start + field.count); i++) {
+		out += packet.printable_character(i);
+	}
+}
+
+void console_line(StringBuffer& out, const Packet& packet, const uint32_t frequency) {
+	format_into(out,
+		fmt::datetime(packet.received_at(), HMS), ' ',
+		fmt::dec_uint(frequency / 1000000), '.', fmt::dec_uint((frequency / 1000) % 1000, 3, '0'), ' '
+	);
+	append_field(out, packet, Packet::registration_number_field);
+	out += ' ';
+	append_field(out, packet, Packet::label_field);
+	format_into(out, " #", static_cast<char>(packet.block_id()));
+}
+
+void log_entry(StringBuffer& out, const Packet& packet, const uint32_t frequency) {
+	format_into(out, "F:", fmt::dec_uint(frequency), "Hz M:", static_cast<char>(packet.mode()), " R:");
+	append_field(out, packet, Packet::registration_number_field);
+	out += " L:";
+	append_field(out, packet, Packet::label_field);
+	format_into(out, " B:", static_cast<char>(packet.block_id()), ' ');
+	append_field(out, packet, packet.message_text_field());
+}
+
+} /* namespace format */
+} /* namespace acars */
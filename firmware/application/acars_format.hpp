@@ -0,0 +1,44 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __ACARS_FORMAT_H__
+#define __ACARS_FORMAT_H__
+
+#include "acars_packet.hpp"
+#include "fixed_string.hpp"
+
+#include <cstdint>
+
+namespace acars {
+namespace format {
+
+/* Text for a decoded block, appended to out without touching the heap. Lines
+ * that don't fit are cut short.
+ */
+
+// Time, channel, registration, label and block ID
+void console_line(StringBuffer& out, const Packet& packet, const uint32_t frequency);
+
+// All header fields and the message text, LogFile adds the timestamp
+void log_entry(StringBuffer& out, const Packet& packet, const uint32_t frequency);
+
+} /* namespace format */
+} /* namespace acars */
+
+#endif/*__ACARS_FORMAT_H__*/
@@ -21,6 +21,7 @@
  */
 
 #include "acars_app.hpp"
+#include "acars_format.hpp"
 
 #include "baseband_api.hpp"
 #include "portapack_persistent_memory.hpp"
@@ -31,33 +32,62 @@ using namespace acars;
 #include "string_format.hpp"
 #include "utility.hpp"
 
-void ACARSLogger::log_raw_data(const acars::Packet& packet, const uint32_t frequency) {
-	(void)frequency;
-	std::string entry { };	//= "Raw: F:" + to_string_dec_uint(frequency) + "Hz ";
-	entry.reserve(256);
-	
-	// Raw hex dump of all the bytes
-	//for (size_t c = 0; c < packet.length(); c += 32)
-	//	entry += to_string_hex(packet.read(c, 32), 8) + " ";
-	
-	for (size_t c = 0; c < 256; c += 32)
-		entry += to_string_bin(packet.read(c, 32), 32);
-	
+#include <algorithm>
+
+void ACARSLogger::log_decoded(const acars::Packet& packet, const uint32_t frequency) {
+	// Header fields take 38 characters at most, the text 223
+	FixedString<272> entry;
+	acars::format::log_entry(entry, packet, frequency);
+
 	log_file.write_entry(packet.received_at(), entry);
 }
 
-/*void ACARSLogger::log_decoded(
-	const acars::Packet& packet,
-	const std::string text) {
-	
-	log_file.write_entry(packet.timestamp(), text);
-}*/
-
 namespace ui {
 
+namespace {
+
+struct ChannelSet {
+	size_t count;
+	std::array<rf::Frequency, ACARSConfigureMessage::max_channels> frequencies;
+};
+
+// Entry 0 is the tuned frequency alone
+const std::array<ChannelSet, 3> channel_sets { {
+	{ 1, { } },
+	{ 3, { 131525000, 131725000, 131825000 } },
+	{ 4, { 131525000, 131550000, 131725000, 131825000 } },
+} };
+
+} /* namespace */
+
 void ACARSAppView::update_freq(rf::Frequency f) {
 	set_target_frequency(f);
 	portapack::persistent_memory::set_tuned_frequency(f);	// Maybe not ?
+
+	if (channel_count == 1)
+		channel_frequencies[0] = f;
+
+	std::array<int32_t, ACARSConfigureMessage::max_channels> offsets { };
+	for (size_t i = 0; i < channel_count; i++)
+		offsets[i] = (int64_t)channel_frequencies[i] - (int64_t)f;
+
+	baseband::set_acars(offsets, channel_count);
+}
+
+// Tunes to the middle of the set, so that every channel is in reach
+void ACARSAppView::set_channels(const size_t channel_set) {
+	const auto& set = channel_sets[channel_set];
+	rf::Frequency f = receiver_model.tuning_frequency();
+
+	channel_count = set.count;
+	if (channel_count > 1) {
+		channel_frequencies = set.frequencies;
+		const auto range = std::minmax_element(set.frequencies.begin(), set.frequencies.begin() + set.count);
+		f = (*range.first + *range.second) / 2;
+	}
+
+	field_frequency.set_value(f);
+	update_freq(f);
 }
 
 ACARSAppView::ACARSAppView(NavigationView& nav) {
@@ -70,8 +100,11 @@ ACARSAppView::ACARSAppView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&field_frequency,
+		&options_channels,
 		&check_log,
-		&console
+		&check_stats,
+		&console,
+		&stats_view
 	});
 	
 	receiver_model.set_sampling_rate(2457600);
@@ -93,10 +126,22 @@ ACARSAppView::ACARSAppView(NavigationView& nav) {
 		};
 	};
 	
+	options_channels.set_selected_index(0);
+	options_channels.on_change = [this](size_t index, OptionsField::value_t) {
+		set_channels(index);
+	};
+
 	check_log.set_value(logging);
 	check_log.on_select = [this](Checkbox&, bool v) {
 		logging = v;
 	};
+
+	stats_view.set_parent_rect(console.parent_rect());
+	stats_view.hidden(true);
+	check_stats.on_select = [this](Checkbox&, bool v) {
+		console.hidden(v);
+		stats_view.hidden(!v);
+	};
 	
 	logger = std::make_unique<ACARSLogger>();
 	if (logger)
@@ -112,29 +157,19 @@ void ACARSAppView::focus() {
 	field_frequency.focus();
 }
 
-void ACARSAppView::on_packet(const acars::Packet& packet) {
-	std::string console_info;
-	
-	/*if (!packet.is_valid()) {
-		console_info = to_string_datetime(packet.received_at(), HMS);
-		console_info += " INVALID";
-		
-		console.writeln(console_info);
-	} else {
-		console_info = to_string_datetime(packet.received_at(), HMS);
-		console_info += ":" + to_string_bin(packet.read(0, 32), 32);
-		//console_info += " REG:" + packet.registration_number();
-		
-		console.writeln(console_info);
-	}*/
-	
-	packet_counter++;
-	if (packet_counter % 10 == 0)
-		console.writeln("Block #" + to_string_dec_uint(packet_counter));
-	
-	// Log raw data whatever it contains
+void ACARSAppView::on_packet(const acars::Packet& packet, const uint8_t channel) {
+	// The baseband only sends blocks that passed parity and BCS checks
+	if (!packet.is_valid() || (channel >= channel_count))
+		return;
+
+	const auto frequency = channel_frequencies[channel];
+
+	FixedString<40> console_info;
+	acars::format::console_line(console_info, packet, frequency);
+	console.writeln(console_info);
+
 	if (logger && logging)
-		logger->log_raw_data(packet, target_frequency());
+		logger->log_decoded(packet, frequency);
 }
 
 void ACARSAppView::set_target_frequency(const uint32_t new_value) {
@@ -26,6 +26,7 @@
 #include "ui_widget.hpp"
 #include "ui_receiver.hpp"
 #include "ui_rssi.hpp"
+#include "ui_baseband_stats_view.hpp"
 
 #include "log_file.hpp"
 
@@ -37,8 +38,7 @@ public:
 		return log_file.append(filename);
 	}
 	
-	void log_raw_data(const acars::Packet& packet, const uint32_t frequency);
-	//void log_decoded(const acars::Packet& packet, const std::string text);
+	void log_decoded(const acars::Packet& packet, const uint32_t frequency);
 
 private:
 	LogFile log_file { };
@@ -57,7 +57,6 @@ public:
 
 private:
 	bool logging { false };
-	uint32_t packet_counter { 0 };
 
 	RFAmpField field_rf_amp {
 		{ 13 * 8, 0 * 16 }
@@ -78,24 +77,46 @@ private:
 	FrequencyField field_frequency {
 		{ 0 * 8, 0 * 8 },
 	};
+	OptionsField options_channels {
+		{ 0 * 8, 21 },
+		19,
+		{
+			{ "Single channel", 0 },
+			{ "131.525/725/825", 1 },
+			{ "131.525/550/725/825", 2 },
+		}
+	};
 	Checkbox check_log {
 		{ 22 * 8, 21 },
 		3,
 		"LOG",
 		true
 	};
+	// Swaps the console for the baseband's load and cycle profile
+	Checkbox check_stats {
+		{ 0 * 8, 3 * 16 },
+		5,
+		"Stats",
+		true
+	};
 
 	Console console {
-		{ 0, 3 * 16, 240, 256 }
+		{ 0, 4 * 16, 240, 240 }
 	};
+	BasebandStatsView stats_view { };
 
 	std::unique_ptr<ACARSLogger> logger { };
 
 	uint32_t target_frequency_ { };
+
+	// Channels out of the baseband's reach from the tuned frequency are skipped
+	std::array<rf::Frequency, ACARSConfigureMessage::max_channels> channel_frequencies { };
+	size_t channel_count { 1 };
 	
 	void update_freq(rf::Frequency f);
+	void set_channels(const size_t channel_set);
 
-	void on_packet(const acars::Packet& packet);
+	void on_packet(const acars::Packet& packet, const uint8_t channel);
 
 	uint32_t target_frequency() const;
 	void set_target_frequency(const uint32_t new_value);
@@ -105,7 +126,7 @@ private:
 		[this](Message* const p) {
 			const auto message = static_cast<const ACARSPacketMessage*>(p);
 			const acars::Packet packet { message->packet };
-			this->on_packet(packet);
+			this->on_packet(packet, message->channel);
 		}
 	};
 
@@ -196,11 +196,12 @@ void RecentEntriesTable<AISRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string line = ais::format::mmsi(entry.mmsi) + " ";
+	FixedString<30> line;
+	format_into(line, fmt::dec_uint(entry.mmsi, 9), ' ');
 	if( !entry.name.empty() ) {
-		line += entry.name;
+		format_into(line, entry.name);
 	} else {
-		line += entry.call_sign;
+		format_into(line, entry.call_sign);
 	}
 
 	line.resize(target_rect.width() / 8, ' ');
@@ -48,6 +48,7 @@ using namespace lpc43xx;
 #include <iterator>
 
 #include "recent_entries.hpp"
+#include "packet_dedup.hpp"
 
 struct AISPosition {
 	rtc::RTC timestamp { };
@@ -220,12 +221,15 @@ private:
 		{ 21 * 8, 5, 6 * 8, 4 },
 	};
 
+	// Stationary stations send the very same report over and over
+	PacketDedup dedup { 10000 };
+
 	MessageHandlerRegistration message_handler_packet {
 		Message::ID::AISPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const AISPacketMessage*>(p);
 			const ais::Packet packet { message->packet };
-			if( packet.is_valid() ) {
+			if( packet.is_valid() && !dedup.is_repeat(message->packet) ) {
 				this->on_packet(packet);
 			}
 		}
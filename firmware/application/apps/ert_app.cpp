@@ -33,35 +33,6 @@ using namespace portapack;
 
 #include "ui_receiver.hpp"
 
-namespace ert {
-
-namespace format {
-
-std::string type(Packet::Type value) {
-	switch(value) {
-	default:
-	case Packet::Type::Unknown:	return "???";
-	case Packet::Type::IDM:		return "IDM";
-	case Packet::Type::SCM:		return "SCM";
-	}
-}
-
-std::string id(ID value) {
-	return to_string_dec_uint(value, 10);
-}
-
-std::string consumption(Consumption value) {
-	return to_string_dec_uint(value, 10);
-}
-
-std::string commodity_type(CommodityType value) {
-	return to_string_dec_uint(value, 2);
-}
-
-} /* namespace format */
-
-} /* namespace ert */
-
 void ERTLogger::on_packet(const ert::Packet& packet) {
 	const auto formatted = packet.symbols_formatted();
 	log_file.write_entry(packet.received_at(), formatted.data + "/" + formatted.errors);
@@ -84,12 +55,17 @@ void RecentEntriesTable<ERTRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string line = ert::format::id(entry.id) + " " + ert::format::commodity_type(entry.commodity_type) + " " + ert::format::consumption(entry.last_consumption);
+	FixedString<30> line;
+	format_into(line,
+		fmt::dec_uint(entry.id, 10), ' ',
+		fmt::dec_uint(entry.commodity_type, 2), ' ',
+		fmt::dec_uint(entry.last_consumption, 10)
+	);
 
 	if( entry.received_count > 999 ) {
-		line += " +++";
+		format_into(line, " +++");
 	} else {
-		line += " " + to_string_dec_uint(entry.received_count, 3);
+		format_into(line, ' ', fmt::dec_uint(entry.received_count, 3));
 	}
 
 	line.resize(target_rect.width() / 8, ' ');
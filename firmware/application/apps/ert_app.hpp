@@ -34,6 +34,7 @@
 #include "ert_packet.hpp"
 
 #include "recent_entries.hpp"
+#include "packet_dedup.hpp"
 
 #include <cstddef>
 #include <string>
@@ -161,11 +162,18 @@ private:
 		{ 21 * 8, 0, 6 * 8, 4 },
 	};
 
+	// Meters repeat the same reading until it changes
+	PacketDedup dedup { 30000 };
+
 	MessageHandlerRegistration message_handler_packet {
 		Message::ID::ERTPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const ERTPacketMessage*>(p);
 			const ert::Packet packet { message->type, message->packet };
+			// Bad CRCs don't repeat, and would only push good packets out
+			if( packet.crc_ok() && dedup.is_repeat(message->packet) ) {
+				return;
+			}
 			this->on_packet(packet);
 		}
 	};
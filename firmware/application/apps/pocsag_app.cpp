@@ -39,6 +39,10 @@ void POCSAGLogger::log_raw_data(const pocsag::POCSAGPacket& packet, const uint32
 	for (size_t c = 0; c < 16; c++)
 		entry += to_string_hex(packet[c], 8) + " ";
 	
+	// BCH correction results, one bit per codeword
+	entry += "Corrected:" + to_string_hex(packet.corrected_mask(), 4) +
+			" Failed:" + to_string_hex(packet.failed_mask(), 4);
+	
 	log_file.write_entry(packet.timestamp(), entry);
 }
 
@@ -106,7 +110,7 @@ POCSAGAppView::POCSAGAppView(NavigationView& nav) {
 	options_bitrate.on_change = [this](size_t, OptionsField::value_t v) {
 		on_config_changed(v, options_phase.selected_index_value());
 	};
-	options_bitrate.set_selected_index(1);	// 1200bps
+	options_bitrate.set_selected_index(4);	// Auto
 	
 	options_phase.on_change = [this](size_t, OptionsField::value_t v) {
 		on_config_changed(options_bitrate.selected_index_value(),v);
@@ -93,7 +93,8 @@ private:
 			{ "512bps ", 0 },
 			{ "1200bps", 1 },
 			{ "2400bps", 2 },
-			{ "3200bps", 3 }
+			{ "3200bps", 3 },
+			{ "Auto   ", 4 }
 		}
 	};
 	OptionsField options_mode {
@@ -97,8 +97,6 @@ void SoundBoardView::start_tx(const uint32_t id) {
 	auto reader = std::make_unique<WAVFileReader>();
 	uint32_t tone_key_index = options_tone_key.selected_index();
 	uint32_t sample_rate;
-	uint8_t bit_type = 0; // 0 - 8bit, 1 - 16bit
-	uint8_t channels = 0; // 0 - 1 ch, 1 - 2ch
 	
 	stop();
 
@@ -110,10 +108,9 @@ void SoundBoardView::start_tx(const uint32_t id) {
 	playing_id = id;
 
 	sample_rate = reader->sample_rate();
-	bit_type = reader->bits_per_sample() == 8 ? 0 : 1;
-	channels = reader->channels() - 1;
 	
-	progressbar.set_max(reader->sample_count() * (bit_type ? 2 : 1));
+	// Baseband progress is in bytes of the 16-bit mono stream
+	progressbar.set_max(reader->sample_count() / reader->channels() * 2);
 	
 	//button_play.set_bitmap(&bitmap_stop);
 
@@ -127,15 +124,13 @@ void SoundBoardView::start_tx(const uint32_t id) {
 		0,	// Gain is unused
 		TONES_F2D(tone_key_frequency(tone_key_index), 1536000),
 		field_speed.value(),
-		bit_type,
-		channels,
 		field_modulation.selected_index_value()
 	);
 	baseband::set_sample_rate(sample_rate);
 
 	// Put replay thread to be initialized at last. maybe meaningful.
 	replay_thread = std::make_unique<ReplayThread>(
-		std::move(reader),
+		std::make_unique<WAVStreamReader>(std::move(reader)),
 		read_size, buffer_count,
 		&ready_signal,
 		[](uint32_t return_code) {
@@ -164,6 +159,17 @@ void SoundBoardView::show_infos() {
 	text_title.set(reader->title().substr(0, 22));
 	text_samplerate.set(to_string_dec_uint(reader->sample_rate()));
 	
+	// Envelope preview, the .PKS sidecar is built on first view
+	auto peaks = std::make_unique<WAVPeaks>();
+	if (peaks->open(*reader, u"/WAV/" + file_list[menu_view.highlighted_index()].native()))
+		peaks->read(0, (peaks->sample_count() + 63) / 64, preview_peaks, 64);
+	else
+		memset(preview_peaks, 0, sizeof(preview_peaks));
+	for (size_t i = 0; i < 64; i++) {
+		preview_buffer[i * 2] = preview_peaks[i].min << 8;
+		preview_buffer[i * 2 + 1] = preview_peaks[i].max << 8;
+	}
+	
 	menu_view.hidden(true);
 	page_info.hidden(true);
 	button_next_page.hidden(true);
@@ -174,6 +180,7 @@ void SoundBoardView::show_infos() {
 	text_duration.hidden(false);
 	text_title.hidden(false);
 	text_samplerate.hidden(false);
+	waveform_preview.hidden(false);
 	check_audio.hidden(false);
 	field_volume.hidden(false);
 	field_speed.hidden(false);
@@ -190,6 +197,7 @@ void SoundBoardView::hide_infos() {
 	text_duration.hidden(true);
 	text_title.hidden(true);
 	text_samplerate.hidden(true);
+	waveform_preview.hidden(true);
 	check_audio.hidden(true);
 	field_volume.hidden(true);
 	field_speed.hidden(true);
@@ -314,6 +322,7 @@ SoundBoardView::SoundBoardView(
 		&text_title,
 		&text_duration,
 		&text_samplerate,
+		&waveform_preview,
 		&check_audio,
 		&field_volume,
 		&field_speed,
@@ -333,6 +342,7 @@ SoundBoardView::SoundBoardView(
 	text_title.hidden(true);
 	text_duration.hidden(true);
 	text_samplerate.hidden(true);
+	waveform_preview.hidden(true);
 	check_audio.hidden(true);
 	button_info_back.hidden(true);
 	field_volume.hidden(true);
@@ -29,6 +29,7 @@
 #include "baseband_api.hpp"
 #include "lfsr_random.hpp"
 #include "io_wave.hpp"
+#include "wav_peaks.hpp"
 #include "tone_key.hpp"
 
 namespace ui {
@@ -63,13 +64,16 @@ private:
 	
 	std::vector<std::filesystem::path> file_list { };
 
-	const size_t read_size { 2048 };	// Less ?
-	const size_t buffer_count { 3 };
+	const size_t read_size { 4096 };	// 16-bit mono after conversion
+	const size_t buffer_count { 4 };
 	std::unique_ptr<ReplayThread> replay_thread { };
 	bool ready_signal { false };
 	lfsr_word_t lfsr_v = 1;
 	
 	bool error { false };
+	
+	WAVPeaks::Peak preview_peaks[64] { };
+	int16_t preview_buffer[128] { };	// Min/max pairs, one per pixel
 
 	//void show_infos();
 	void start_tx(const uint32_t id);
@@ -144,6 +148,15 @@ private:
 		{ 14 * 8, 7 * 8, 6 * 8, 16 }
 	};
 
+	Waveform waveform_preview {
+		{ 21 * 8, 5 * 8, 8 * 8, 3 * 8 },
+		preview_buffer,
+		128,
+		0,
+		false,
+		Color::white()
+	};
+
 	Checkbox check_audio {
 		{ 2 * 8, 10 * 8 },
 		16,
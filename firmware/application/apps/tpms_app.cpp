@@ -34,26 +34,6 @@ namespace tpms {
 
 namespace format {
 
-std::string type(Reading::Type type) {
-	return to_string_dec_uint(toUType(type), 2);
-}
-
-std::string id(TransponderID id) {
-	return to_string_hex(id.value(), 8);
-}
-
-std::string pressure(Pressure pressure) {
-	return to_string_dec_int(pressure.kilopascal(), 3);
-}
-
-std::string temperature(Temperature temperature) {
-	return to_string_dec_int(temperature.celsius(), 3);
-}
-
-std::string flags(Flags flags) {
-	return to_string_hex(flags, 2);
-}
-
 static std::string signal_type(SignalType signal_type) {
 	switch(signal_type) {
 	case SignalType::FSK_19k2_Schrader:		return "FSK 38400 19200 Schrader";
@@ -102,30 +82,31 @@ void RecentEntriesTable<TPMSRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string line = tpms::format::type(entry.type) + " " + tpms::format::id(entry.id);
+	FixedString<30> line;
+	format_into(line, fmt::dec_uint(toUType(entry.type), 2), ' ', fmt::hex(entry.id.value(), 8));
 
 	if( entry.last_pressure.is_valid() ) {
-		line += " " + tpms::format::pressure(entry.last_pressure.value());
+		format_into(line, ' ', fmt::dec_int(entry.last_pressure.value().kilopascal(), 3));
 	} else {
-		line += " " "   ";
+		format_into(line, " " "   ");
 	}
 
 	if( entry.last_temperature.is_valid() ) {
-		line += " " + tpms::format::temperature(entry.last_temperature.value());
+		format_into(line, ' ', fmt::dec_int(entry.last_temperature.value().celsius(), 3));
 	} else {
-		line += " " "   ";
+		format_into(line, " " "   ");
 	}
 
 	if( entry.received_count > 999 ) {
-		line += " +++";
+		format_into(line, " +++");
 	} else {
-		line += " " + to_string_dec_uint(entry.received_count, 3);
+		format_into(line, ' ', fmt::dec_uint(entry.received_count, 3));
 	}
 
 	if( entry.last_flags.is_valid() ) {
-		line += " " + tpms::format::flags(entry.last_flags.value());
+		format_into(line, ' ', fmt::hex(entry.last_flags.value(), 2));
 	} else {
-		line += " " "  ";
+		format_into(line, " " "  ");
 	}
 
 	line.resize(target_rect.width() / 8, ' ');
@@ -181,12 +162,11 @@ void TPMSAppView::set_parent_rect(const Rect new_parent_rect) {
 	recent_entries_view.set_parent_rect({ 0, header_height, new_parent_rect.width(), new_parent_rect.height() - header_height });
 }
 
-void TPMSAppView::on_packet(const tpms::Packet& packet) {
+void TPMSAppView::on_packet(const tpms::Packet& packet, const Optional<tpms::Reading>& reading_opt) {
 	if( logger ) {
 		logger->on_packet(packet, target_frequency());
 	}
 
-	const auto reading_opt = packet.reading();
 	if( reading_opt.is_valid() ) {
 		const auto reading = reading_opt.value();
 		auto& entry = ::on_packet(recent, TPMSRecentEntry::Key { reading.type(), reading.id() });
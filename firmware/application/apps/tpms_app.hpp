@@ -33,6 +33,7 @@
 #include "log_file.hpp"
 
 #include "recent_entries.hpp"
+#include "packet_dedup.hpp"
 
 #include "tpms_packet.hpp"
 
@@ -110,12 +111,20 @@ private:
 	static constexpr uint32_t sampling_rate = 2457600;
 	static constexpr uint32_t baseband_bandwidth = 1750000;
 
+	// Sensors send each reading several times in a burst
+	PacketDedup dedup { 5000 };
+
 	MessageHandlerRegistration message_handler_packet {
 		Message::ID::TPMSPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const TPMSPacketMessage*>(p);
 			const tpms::Packet packet { message->packet, message->signal_type };
-			this->on_packet(packet);
+			const auto reading = packet.reading();
+			// Undecodable packets don't repeat, and would only push good ones out
+			if( reading.is_valid() && dedup.is_repeat(message->packet) ) {
+				return;
+			}
+			this->on_packet(packet, reading);
 		}
 	};
 
@@ -165,7 +174,7 @@ private:
 
 	uint32_t target_frequency_ = initial_target_frequency;
 
-	void on_packet(const tpms::Packet& packet);
+	void on_packet(const tpms::Packet& packet, const Optional<tpms::Reading>& reading_opt);
 	void on_show_list();
 
 	void on_band_changed(const uint32_t new_band_frequency);
@@ -55,12 +55,13 @@ void RecentEntriesTable<AircraftRecentEntries>::draw(
 		target_color = Color::dark_grey();
 	}
 	
-	std::string entry_string = "\x1B";
-	entry_string += aged_color;
-	entry_string += to_string_hex(entry.ICAO_address, 6) + " " +
-		entry.callsign + "  " +
-		(entry.hits <= 999 ? to_string_dec_uint(entry.hits, 4) : "999+") + " " + 
-		entry.time_string;
+	FixedString<40> entry_string;
+	format_into(entry_string, '\x1B', aged_color, fmt::hex(entry.ICAO_address, 6), ' ', entry.callsign, "  ");
+	if (entry.hits <= 999)
+		format_into(entry_string, fmt::dec_uint(entry.hits, 4));
+	else
+		format_into(entry_string, "999+");
+	format_into(entry_string, ' ', entry.time_string);
 	
 	painter.draw_string(
 		target_rect.location(),
@@ -72,7 +73,7 @@ void RecentEntriesTable<AircraftRecentEntries>::draw(
 		painter.draw_bitmap(target_rect.location() + Point(15 * 8, 0), bitmap_target, target_color, style.background);
 }
 
-void ADSBLogger::log_str(std::string& logline) {
+void ADSBLogger::log_str(const std::string_view logline) {
 	rtc::RTC datetime;
 	rtcGetTime(&RTCD1, &datetime);
 	log_file.write_entry(datetime,logline);
@@ -204,10 +205,7 @@ ADSBRxView::~ADSBRxView() {
 
 void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 	rtc::RTC datetime;
-	std::string str_timestamp;
-	std::string callsign;
-	std::string str_info;
-	std::string logentry;
+	FixedString<96> logentry;
 
 	auto frame = message->frame;
 	uint32_t ICAO_address = frame.get_ICAO_address();
@@ -217,12 +215,13 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 		auto& entry = ::on_packet(recent, ICAO_address);
 		frame.set_rx_timestamp(datetime.minute() * 60 + datetime.second());
 		entry.reset_age();
-		str_timestamp = to_string_datetime(datetime, HMS);
+
+		FixedString<8> str_timestamp;
+		format_into(str_timestamp, fmt::datetime(datetime, HMS));
 		entry.set_time_string(str_timestamp);
 
 		entry.inc_hit();
-		logentry += to_string_hex_array(frame.get_raw_data(), 14) + " ";
-		logentry += "ICAO:" + to_string_hex(ICAO_address, 6) + " ";
+		format_into(logentry, fmt::hex_array(frame.get_raw_data(), 14), " ICAO:", fmt::hex(ICAO_address, 6), ' ');
 		
 		if (frame.get_DF() == DF_ADSB) {
 			uint8_t msg_type = frame.get_msg_type();
@@ -230,43 +229,45 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 			uint8_t * raw_data = frame.get_raw_data();
 			
 			if ((msg_type >= 1) && (msg_type <= 4)) {
-				callsign = decode_frame_id(frame);
+				const auto callsign = decode_frame_id(frame);
 				entry.set_callsign(callsign);
-				logentry+=callsign+" ";
+				format_into(logentry, callsign, ' ');
 			} else if (((msg_type >= 9) && (msg_type <= 18)) || ((msg_type >= 20) && (msg_type <= 22))) {
 				entry.set_frame_pos(frame, raw_data[6] & 4);
 				
 				if (entry.pos.valid) {
-					str_info = "Alt:" + to_string_dec_int(entry.pos.altitude) +
-						" Lat:" + to_string_dec_int(entry.pos.latitude) +
-						"." + to_string_dec_int((int)abs(entry.pos.latitude * 1000) % 100, 2, '0') +
-						" Lon:" + to_string_dec_int(entry.pos.longitude) +
-						"." + to_string_dec_int((int)abs(entry.pos.longitude * 1000) % 100, 2, '0');
+					FixedString<48> str_info;
+					format_into(str_info,
+						"Alt:", fmt::dec_int(entry.pos.altitude),
+						" Lat:", fmt::dec_int(entry.pos.latitude),
+						'.', fmt::dec_int((int)abs(entry.pos.latitude * 1000) % 100, 2, '0'),
+						" Lon:", fmt::dec_int(entry.pos.longitude),
+						'.', fmt::dec_int((int)abs(entry.pos.longitude * 1000) % 100, 2, '0')
+					);
 					
 					entry.set_info_string(str_info);
-					logentry+=str_info+ " ";
+					format_into(logentry, str_info, ' ');
 
 					if (send_updates && details_view->is_selected(entry))
 						details_view->update(entry);
 				}
 			} else if(msg_type == 19 && msg_sub >= 1 && msg_sub <= 4){
 				entry.set_frame_velo(frame);
-				logentry += "Type:" + to_string_dec_uint(msg_sub) +
-							" Hdg:" + to_string_dec_uint(entry.velo.heading) +
-							" Spd: "+ to_string_dec_int(entry.velo.speed);
+				format_into(logentry,
+					"Type:", fmt::dec_uint(msg_sub),
+					" Hdg:", fmt::dec_uint(entry.velo.heading),
+					" Spd: ", fmt::dec_int(entry.velo.speed)
+				);
 				if (send_updates && details_view->is_selected(entry))
 					details_view->update(entry);
 			}
 		}
 		recent_entries_view.set_dirty(); 
 		
-		logger = std::make_unique<ADSBLogger>();
-        if (logger) {
-                logger->append(u"adsb.txt");
-                // will log each frame in format:
-                // 20171103100227 8DADBEEFDEADBEEFDEADBEEFDEADBEEF ICAO:nnnnnn callsign Alt:nnnnnn Latnnn.nn Lonnnn.nn
-				logger->log_str(logentry);
-        }
+		// will log each frame in format:
+		// 20171103100227 8DADBEEFDEADBEEFDEADBEEFDEADBEEF ICAO:nnnnnn callsign Alt:nnnnnn Latnnn.nn Lonnnn.nn
+		if (logger)
+			logger->log_str(logentry);
 	}
 }
 
@@ -320,6 +321,10 @@ ADSBRxView::ADSBRxView(NavigationView& nav) {
 	receiver_model.set_sampling_rate(2000000);
 	receiver_model.set_baseband_bandwidth(2500000);
 	receiver_model.enable();
+
+	logger = std::make_unique<ADSBLogger>();
+	if (logger)
+		logger->append(u"adsb.txt");
 }
 
 } /* namespace ui */
@@ -67,8 +67,8 @@ struct AircraftRecentEntry {
 		return ICAO_address;
 	}
 	
-	void set_callsign(std::string& new_callsign) {
-		callsign = new_callsign;
+	void set_callsign(const std::string_view new_callsign) {
+		callsign.assign(new_callsign);
 	}
 	
 	void inc_hit() {
@@ -91,12 +91,12 @@ struct AircraftRecentEntry {
 		velo = decode_frame_velo(frame);
 	}
 	
-	void set_info_string(std::string& new_info_string) {
-		info_string = new_info_string;
+	void set_info_string(const std::string_view new_info_string) {
+		info_string.assign(new_info_string);
 	}
 	
-	void set_time_string(std::string& new_time_string) {
-		time_string = new_time_string;
+	void set_time_string(const std::string_view new_time_string) {
+		time_string.assign(new_time_string);
 	}
 	
 	void reset_age() {
@@ -115,7 +115,7 @@ public:
 	Optional<File::Error> append(const std::filesystem::path& filename) {
 		return log_file.append(filename);
 	}
-	void log_str(std::string& logline);
+	void log_str(const std::string_view logline);
 
 private:
 	LogFile log_file { };
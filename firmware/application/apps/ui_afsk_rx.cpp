@@ -62,6 +62,7 @@ AFSKRxView::AFSKRxView(NavigationView& nav) {
 		&field_frequency,
 		&text_debug,
 		&button_modem_setup,
+		&options_mode,
 		&record_view,
 		&console
 	});
@@ -100,12 +101,17 @@ AFSKRxView::AFSKRxView(NavigationView& nav) {
 		nav.push<ModemSetupView>();
 	};
 	
+	options_mode.set_selected_index(0);
+	options_mode.on_change = [this](size_t, OptionsField::value_t v) {
+		baseband::set_afsk(persistent_memory::modem_baudrate(), 8, v);
+	};
+	
 	logger = std::make_unique<AFSKLogger>();
 	if (logger)
 		logger->append("AFSK_LOG.TXT");
 	
 	// Auto-configure modem for LCR RX (will be removed later)
-	baseband::set_afsk(persistent_memory::modem_baudrate(), 8, 0, false);
+	baseband::set_afsk(persistent_memory::modem_baudrate(), 8, false);
 	
 	audio::set_rate(audio::Rate::Hz_24000);
 	audio::output::start();
@@ -163,6 +169,33 @@ void AFSKRxView::on_data(uint32_t value, bool is_data) {
 	}
 }
 
+// One line per frame. AX.25 address bytes are shifted left, the LSB marks the last one
+void AFSKRxView::on_frame(const AFSKFrameMessage& message) {
+	std::string str_console = "\x1B";
+	std::string str_frame = "";
+	bool in_address = true;
+	
+	str_console += (char)((console_color++ & 3) + 9);
+	
+	for (size_t i = 0; i < message.size; i++) {
+		uint8_t value = message.data[i];
+		
+		if (in_address) {
+			in_address = !(value & 1);
+			value >>= 1;
+		}
+		
+		if ((value >= 32) && (value < 127))
+			str_frame += (char)value;
+		else
+			str_frame += "[" + to_string_hex(value, 2) + "]";
+	}
+	
+	console.writeln(str_console + str_frame);
+	
+	if (logger) logger->log_raw_data(str_frame);
+}
+
 AFSKRxView::~AFSKRxView() {
 	audio::output::stop();
 	receiver_model.disable();
@@ -56,6 +56,7 @@ public:
 	
 private:
 	void on_data(uint32_t value, bool is_data);
+	void on_frame(const AFSKFrameMessage& message);
 	
 	uint8_t console_color { 0 };
 	uint32_t prev_value { 0 };
@@ -92,6 +93,15 @@ private:
 		"Modem setup"
 	};
 	
+	OptionsField options_mode {
+		{ 25 * 8, 1 * 16 },
+		5,
+		{
+			{ "Async", 0 },
+			{ "AX.25", 1 }
+		}
+	};
+	
 	// DEBUG
 	RecordView record_view {
 		{ 0 * 8, 3 * 16, 30 * 8, 1 * 16 },
@@ -114,6 +124,13 @@ private:
 			this->on_data(message->value, message->is_data);
 		}
 	};
+	
+	MessageHandlerRegistration message_handler_frame {
+		Message::ID::AFSKFrame,
+		[this](Message* const p) {
+			this->on_frame(*static_cast<const AFSKFrameMessage*>(p));
+		}
+	};
 };
 
 } /* namespace ui */
@@ -395,8 +395,12 @@ APRSRXView::APRSRXView(NavigationView& nav) : nav_ {nav} {
 	add_children({
 		&tab_view,
 		&view_stream,
-		&view_table
+		&view_table,
+		&view_stats
 	});
+
+	view_stats.set_parent_rect(view_rect);
+	view_stats.hidden(true);
 }
 
 void APRSRXView::focus(){
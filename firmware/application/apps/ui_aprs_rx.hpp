@@ -28,8 +28,10 @@
 #include "ui_receiver.hpp"
 #include "ui_record_view.hpp"	// DEBUG
 #include "ui_geomap.hpp"
+#include "ui_baseband_stats_view.hpp"
 
 #include "recent_entries.hpp"
+#include "packet_dedup.hpp"
 #include "ui_tabview.hpp"
 
 #include "log_file.hpp"
@@ -255,16 +257,24 @@ private:
 	
 	APRSRxView view_stream { nav_, view_rect };
 	APRSTableView view_table { nav_, view_rect };
+	BasebandStatsView view_stats { };
 	
 	TabView tab_view {
 		{ "Stream", Color::cyan(), &view_stream },
-		{ "List", Color::yellow(), &view_table }
+		{ "List", Color::yellow(), &view_table },
+		{ "Stats", Color::light_grey(), &view_stats }
 	};
 
+	// Digipeated copies differ in their path, so only true repeats are dropped
+	PacketDedup dedup { 30000 };
+
 	MessageHandlerRegistration message_handler_packet {
 		Message::ID::APRSPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const APRSPacketMessage*>(p);
+			if( dedup.is_repeat(message->packet.data(), message->packet.size()) ) {
+				return;
+			}
 			this->view_stream.on_packet(message);
 			this->view_table.on_pkt(message);
 		}
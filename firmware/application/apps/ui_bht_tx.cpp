@@ -35,6 +35,7 @@ void BHTView::focus() {
 }
 
 void BHTView::start_tx() {
+	tx_thread.reset();
 	baseband::shutdown();
 	
 	transmitter_model.set_baseband_bandwidth(1750000);
@@ -64,7 +65,8 @@ void BHTView::start_tx() {
 		
 		baseband::run_image(portapack::spi_flash::image_tag_ook);
 		
-		auto bitstream_length = view_EPAR.generate_message();
+		auto fragments = view_EPAR.generate_message();
+		const size_t bitstream_length = fragments.size();
 		
 		//if (tx_mode == SINGLE) {
 			progressbar.set_max(2 * EPAR_REPEAT_COUNT);
@@ -72,6 +74,14 @@ void BHTView::start_tx() {
 			progressbar.set_max(2 * EPAR_REPEAT_COUNT * view_EPAR.get_scan_remaining());
 		}*/
 		
+		ready_signal = false;
+		tx_thread = std::make_unique<ReplayThread>(
+			std::make_unique<FragmentsReader>(std::move(fragments), EPAR_REPEAT_COUNT),
+			tx_read_size, tx_buffer_count,
+			&ready_signal,
+			nullptr
+		);
+		
 		transmitter_model.set_sampling_rate(OOK_SAMPLERATE);
 		transmitter_model.enable();
 
@@ -79,12 +89,14 @@ void BHTView::start_tx() {
 			bitstream_length,
 			EPAR_BIT_DURATION,
 			EPAR_REPEAT_COUNT,
-			encoder_defs[ENCODER_UM3750].pause_symbols
+			encoder_defs[ENCODER_UM3750].pause_symbols,
+			true
 		);
 	}
 }
 
 void BHTView::stop_tx() {
+	tx_thread.reset();
 	transmitter_model.disable();
 	baseband::shutdown();
 	tx_mode = IDLE;
@@ -140,6 +152,7 @@ void BHTView::on_tx_progress(const uint32_t progress, const bool done) {
 }
 
 BHTView::~BHTView() {
+	tx_thread.reset();
 	transmitter_model.disable();
 }
 
@@ -206,7 +219,7 @@ void EPARView::flip_relays() {
 	relay_states[0].set_selected_index(relay_states[0].selected_index() ^ 1);
 }
 
-size_t EPARView::generate_message() {
+std::string EPARView::generate_message() {
 	// R2, then R1
 	return gen_message_ep(field_city.value(), field_group.selected_index_value(),
 							half ? 0 : 1, relay_states[half].selected_index());
@@ -33,6 +33,7 @@
 #include "transmitter_model.hpp"
 #include "encoders.hpp"
 #include "portapack.hpp"
+#include "replay_thread.hpp"
 
 namespace ui {
 
@@ -131,7 +132,7 @@ public:
 	void focus() override;
 	
 	void flip_relays();
-	size_t generate_message();
+	std::string generate_message();
 	bool increment_address();
 	uint32_t get_scan_remaining();
 
@@ -200,6 +201,12 @@ private:
 	
 	tx_modes tx_mode = IDLE;
 	
+	// EPAR frames are streamed to the baseband, double buffered
+	static constexpr size_t tx_read_size { 512 };
+	static constexpr size_t tx_buffer_count { 2 };
+	std::unique_ptr<ReplayThread> tx_thread { };
+	bool ready_signal { false };
+	
 	Rect view_rect = { 0, 3 * 8, 240, 176 };
 	
 	XylosView view_xylos { view_rect };
@@ -250,6 +257,16 @@ private:
 			this->on_tx_progress(message.progress, message.done);
 		}
 	};
+	
+	MessageHandlerRegistration message_handler_fifo_signal {
+		Message::ID::RequestSignal,
+		[this](const Message* const p) {
+			const auto message = static_cast<const RequestSignalMessage*>(p);
+			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+				ready_signal = true;
+			}
+		}
+	};
 };
 
 } /* namespace ui */
@@ -42,6 +42,18 @@ void BTLERxView::focus() {
 
 void BTLERxView::update_freq(rf::Frequency f) {
 	receiver_model.set_tuning_frequency(f);
+	
+	// Advertising channels need their own de-whitening sequence
+	if (f == 2402000000)
+		channel_number = 37;
+	else if (f == 2426000000)
+		channel_number = 38;
+	else if (f == 2480000000)
+		channel_number = 39;
+	else
+		return;
+	
+	baseband::set_btle(persistent_memory::modem_baudrate(), 8, 0, false, channel_number);
 }
 
 BTLERxView::BTLERxView(NavigationView& nav) {
@@ -96,7 +108,7 @@ BTLERxView::BTLERxView(NavigationView& nav) {
 	
 	
 	// Auto-configure modem for LCR RX (will be removed later)
-	baseband::set_btle(persistent_memory::modem_baudrate(), 8, 0, false);
+	baseband::set_btle(persistent_memory::modem_baudrate(), 8, 0, false, channel_number);
 	
 	audio::set_rate(audio::Rate::Hz_24000);
 	audio::output::start();
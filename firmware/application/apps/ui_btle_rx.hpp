@@ -47,6 +47,7 @@ private:
 	
 	uint8_t console_color { 0 };
 	uint32_t prev_value { 0 };
+	uint8_t channel_number { 38 };
 	std::string str_log { "" };
 
 	RFAmpField field_rf_amp {
@@ -24,12 +24,16 @@
 #include "ch.h"
 
 #include "radio.hpp"
+#include "core_control.hpp"
 #include "string_format.hpp"
 
 #include "audio.hpp"
+#include "baseband_api.hpp"
 
 #include "ui_sd_card_debug.hpp"
 
+#include "rtc_time.hpp"
+
 #include "portapack.hpp"
 using namespace portapack;
 
@@ -48,6 +52,10 @@ DebugMemoryView::DebugMemoryView(NavigationView& nav) {
 		&text_label_m0_heap_fragmented_free_value,
 		&text_label_m0_heap_fragments,
 		&text_label_m0_heap_fragments_value,
+		&text_label_m4_image_bytes,
+		&text_label_m4_image_bytes_value,
+		&text_label_m4_image_load,
+		&text_label_m4_image_load_value,
 		&button_done
 	});
 
@@ -59,6 +67,10 @@ DebugMemoryView::DebugMemoryView(NavigationView& nav) {
 	text_label_m0_heap_fragmented_free_value.set(to_string_dec_uint(m0_fragmented_free_space, 5));
 	text_label_m0_heap_fragments_value.set(to_string_dec_uint(m0_fragments, 5));
 
+	const auto image_load = debug::image_load_stats();
+	text_label_m4_image_bytes_value.set(to_string_dec_uint(image_load.stored_bytes, 5) + "/" + to_string_dec_uint(image_load.image_bytes, 5));
+	text_label_m4_image_load_value.set(to_string_dec_uint(image_load.last_us, 5) + "/" + to_string_dec_uint(image_load.max_us, 5));
+
 	button_done.on_select = [&nav](Button&){ nav.pop(); };
 }
 
@@ -355,6 +367,137 @@ void DebugControlsView::focus() {
 	switches_widget.focus();
 }
 
+/* DebugBasebandView *****************************************************/
+
+DebugBasebandView::DebugBasebandView(NavigationView& nav) {
+	add_children({
+		&labels,
+		&options_modulation,
+		&text_frequency,
+		&stats_view,
+		&button_done,
+	});
+
+	stats_view.set_parent_rect({ 0, 3 * 16, 30 * 8, 8 * 16 });
+	text_frequency.set(to_string_short_freq(receiver_model.tuning_frequency()));
+
+	options_modulation.on_change = [this](size_t, OptionsField::value_t v) {
+		this->on_modulation_changed(static_cast<ReceiverModel::Mode>(v));
+	};
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+
+	audio::output::start();
+
+	// Also starts the receiver
+	options_modulation.set_by_value(toUType(ReceiverModel::Mode::NarrowbandFMAudio));
+}
+
+DebugBasebandView::~DebugBasebandView() {
+	audio::output::stop();
+	receiver_model.disable();
+	baseband::shutdown();
+}
+
+void DebugBasebandView::focus() {
+	options_modulation.focus();
+}
+
+void DebugBasebandView::on_modulation_changed(const ReceiverModel::Mode modulation) {
+	audio::output::mute();
+	baseband::shutdown();
+
+	switch(modulation) {
+	case ReceiverModel::Mode::AMAudio:				baseband::run_image(portapack::spi_flash::image_tag_am_audio);	break;
+	case ReceiverModel::Mode::WidebandFMAudio:		baseband::run_image(portapack::spi_flash::image_tag_wfm_audio);	break;
+	default:										baseband::run_image(portapack::spi_flash::image_tag_nfm_audio);	break;
+	}
+
+	receiver_model.set_modulation(modulation);
+	receiver_model.set_sampling_rate(3072000);
+	receiver_model.set_baseband_bandwidth(1750000);
+	receiver_model.enable();
+
+	audio::output::unmute();
+}
+
+/* DebugEventsView *******************************************************/
+
+DebugEventsView::DebugEventsView(NavigationView& nav) {
+	add_children({
+		&labels,
+		&check_log,
+		&button_done,
+	});
+
+	for(size_t i = 0; i < text_events.size(); i++) {
+		text_events[i].set_parent_rect({ 6 * 8, static_cast<Coord>((2 + i) * 16), 18 * 8, 16 });
+		add_child(&text_events[i]);
+	}
+	for(size_t i = 0; i < text_queues.size(); i++) {
+		text_queues[i].set_parent_rect({ 6 * 8, static_cast<Coord>((11 + i) * 16), 18 * 8, 16 });
+		add_child(&text_queues[i]);
+	}
+
+	check_log.on_select = [this](Checkbox&, bool v) {
+		logging = v && !log_file.append("EVENTS.TXT").is_valid();
+	};
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+
+	// Queue figures accumulate from here on, event figures are per second
+	shared_memory.application_queue.reset_statistics();
+	shared_memory.app_local_queue.reset_statistics();
+	EventDispatcher::reset_event_stats();
+
+	signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+		this->on_tick_second();
+	};
+}
+
+DebugEventsView::~DebugEventsView() {
+	rtc_time::signal_tick_second -= signal_token_tick_second;
+}
+
+void DebugEventsView::focus() {
+	button_done.focus();
+}
+
+void DebugEventsView::on_tick_second() {
+	std::string log_line { "E" };
+
+	for(size_t i = 0; i < text_events.size(); i++) {
+		const auto stats = EventDispatcher::event_stats(static_cast<EventDispatcher::Event>(i));
+		const uint32_t avg_us = stats.count ? (stats.total_us / stats.count) : 0;
+		text_events[i].set(
+			to_string_dec_uint(stats.count, 4) + " " +
+			to_string_dec_uint(avg_us, 5) + " " +
+			to_string_dec_uint(stats.max_us, 6)
+		);
+		log_line += " " + to_string_dec_uint(stats.count) + "/" + to_string_dec_uint(avg_us) + "/" + to_string_dec_uint(stats.max_us);
+	}
+	EventDispatcher::reset_event_stats();
+
+	log_line += " Q";
+	const MessageQueue* const queues[queue_count] = {
+		&shared_memory.application_queue,
+		&shared_memory.app_local_queue,
+	};
+	for(size_t i = 0; i < text_queues.size(); i++) {
+		const auto stats = queues[i]->statistics();
+		text_queues[i].set(
+			to_string_dec_uint(stats.high_water, 4) + "/" +
+			to_string_dec_uint(queues[i]->capacity(), 4) + " " +
+			to_string_dec_uint(stats.dropped, 7)
+		);
+		log_line += " " + to_string_dec_uint(stats.high_water) + "/" + to_string_dec_uint(stats.dropped);
+	}
+
+	if( logging ) {
+		rtc::RTC datetime;
+		rtcGetTime(&RTCD1, &datetime);
+		log_file.write_entry(datetime, log_line);
+	}
+}
+
 /* DebugPeripheralsMenuView **********************************************/
 
 DebugPeripheralsMenuView::DebugPeripheralsMenuView(NavigationView& nav) {
@@ -389,6 +532,8 @@ DebugMenuView::DebugMenuView(NavigationView& nav) {
 		{ "SD Card",		ui::Color::dark_cyan(),	&bitmap_icon_sdcard,	[&nav](){ nav.push<SDCardDebugView>(); } },
 		{ "Peripherals",	ui::Color::dark_cyan(),	&bitmap_icon_peripherals,	[&nav](){ nav.push<DebugPeripheralsMenuView>(); } },
 		{ "Temperature",	ui::Color::dark_cyan(),	&bitmap_icon_temperature,	[&nav](){ nav.push<TemperatureView>(); } },
+		{ "Baseband",		ui::Color::dark_cyan(),	&bitmap_icon_speaker,	[&nav](){ nav.push<DebugBasebandView>(); } },
+		{ "Event loop",		ui::Color::dark_cyan(),	&bitmap_icon_debug,	[&nav](){ nav.push<DebugEventsView>(); } },
 		{ "Buttons test",	ui::Color::dark_cyan(),	&bitmap_icon_controls,	[&nav](){ nav.push<DebugControlsView>(); } },
 	});
 	set_max_rows(2); // allow wider buttons
@@ -27,10 +27,16 @@
 #include "ui_painter.hpp"
 #include "ui_menu.hpp"
 #include "ui_navigation.hpp"
+#include "ui_baseband_stats_view.hpp"
+
+#include "event_m0.hpp"
+#include "log_file.hpp"
 
 #include "rffc507x.hpp"
 #include "max2837.hpp"
 #include "portapack.hpp"
+#include "receiver_model.hpp"
+#include "utility.hpp"
 
 #include <functional>
 #include <utility>
@@ -76,6 +82,24 @@ private:
 		{ 200, 160, 40, 16 },
 	};
 
+	Text text_label_m4_image_bytes {
+		{ 0, 224, 144, 16 },
+		"M4 Image Flash/RAM",
+	};
+
+	Text text_label_m4_image_bytes_value {
+		{ 152, 224, 88, 16 },
+	};
+
+	Text text_label_m4_image_load {
+		{ 0, 240, 144, 16 },
+		"M4 Load us Last/Max",
+	};
+
+	Text text_label_m4_image_load_value {
+		{ 152, 240, 88, 16 },
+	};
+
 	Button button_done {
 		{ 72, 192, 96, 24 },
 		"Done"
@@ -275,6 +299,94 @@ private:
 	};
 };
 
+// Runs an audio receiver at the current frequency to show its cycle profile
+class DebugBasebandView : public View {
+public:
+	DebugBasebandView(NavigationView& nav);
+	~DebugBasebandView();
+
+	void focus() override;
+
+	std::string title() const override { return "Baseband"; };
+
+private:
+	Labels labels {
+		{ { 0 * 8, 1 * 16 }, "Mode:", Color::light_grey() },
+		{ { 11 * 8, 1 * 16 }, "Freq:", Color::light_grey() },
+	};
+
+	OptionsField options_modulation {
+		{ 6 * 8, 1 * 16 },
+		4,
+		{
+			{ " AM ", toUType(ReceiverModel::Mode::AMAudio) },
+			{ "NFM ", toUType(ReceiverModel::Mode::NarrowbandFMAudio) },
+			{ "WFM ", toUType(ReceiverModel::Mode::WidebandFMAudio) },
+		}
+	};
+
+	Text text_frequency {
+		{ 17 * 8, 1 * 16, 13 * 8, 1 * 16 },
+	};
+
+	BasebandStatsView stats_view { };
+
+	Button button_done {
+		{ 72, 264, 96, 24 },
+		"Done"
+	};
+
+	void on_modulation_changed(const ReceiverModel::Mode modulation);
+};
+
+// Event loop handler times and message queue depths, refreshed every second
+class DebugEventsView : public View {
+public:
+	DebugEventsView(NavigationView& nav);
+	~DebugEventsView();
+
+	void focus() override;
+
+	std::string title() const override { return "Event loop"; };
+
+private:
+	static constexpr size_t queue_count = 2;
+
+	SignalToken signal_token_tick_second { };
+	LogFile log_file { };
+	bool logging { false };
+
+	Labels labels {
+		{ { 0 * 8, 1 * 16 }, "Event  n/s  avg   max us", Color::light_grey() },
+		{ { 0 * 8, 2 * 16 }, "App", Color::light_grey() },
+		{ { 0 * 8, 3 * 16 }, "Local", Color::light_grey() },
+		{ { 0 * 8, 4 * 16 }, "RTC", Color::light_grey() },
+		{ { 0 * 8, 5 * 16 }, "Keys", Color::light_grey() },
+		{ { 0 * 8, 6 * 16 }, "Frame", Color::light_grey() },
+		{ { 0 * 8, 7 * 16 }, "Enc", Color::light_grey() },
+		{ { 0 * 8, 8 * 16 }, "Touch", Color::light_grey() },
+		{ { 0 * 8, 10 * 16 }, "Queue  peak/size   drops", Color::light_grey() },
+		{ { 0 * 8, 11 * 16 }, "App", Color::light_grey() },
+		{ { 0 * 8, 12 * 16 }, "Local", Color::light_grey() },
+	};
+
+	std::array<Text, EventDispatcher::event_count> text_events { };
+	std::array<Text, queue_count> text_queues { };
+
+	Checkbox check_log {
+		{ 0 * 8, 14 * 16 },
+		17,
+		"Log to EVENTS.TXT"
+	};
+
+	Button button_done {
+		{ 72, 264, 96, 24 },
+		"Done"
+	};
+
+	void on_tick_second();
+};
+
 /*class DebugLCRView : public View {
 public:
 	DebugLCRView(NavigationView& nav, std::string lcrstring);
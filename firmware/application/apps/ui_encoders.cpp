@@ -155,7 +155,8 @@ uint8_t EncodersConfigView::repeat_min() {
 }
 
 uint32_t EncodersConfigView::samples_per_bit() {
-	return OOK_SAMPLERATE / ((field_clk.value() * 1000) / encoder_def->clk_per_fragment);
+	// The baseband times symbols to the sample, don't round the fragment rate first
+	return (uint64_t)OOK_SAMPLERATE * encoder_def->clk_per_fragment / (field_clk.value() * 1000);
 }
 
 uint32_t EncodersConfigView::pause_symbols() {
@@ -203,6 +204,7 @@ void EncodersView::focus() {
 }
 
 EncodersView::~EncodersView() {
+	tx_thread.reset();
 	transmitter_model.disable();
 	baseband::shutdown();
 }
@@ -270,6 +272,7 @@ void EncodersView::on_tx_progress(const uint32_t progress, const bool done) {
 				start_tx(true);
 			}
 		} else {*/
+			tx_thread.reset();
 			transmitter_model.disable();
 			tx_mode = IDLE;
 			text_status.set("Done");
@@ -305,7 +308,16 @@ void EncodersView::start_tx(const bool scan) {
 	
 	view_config.generate_frame();
 	
-	bitstream_length = make_bitstream(view_config.frame_fragments);
+	bitstream_length = view_config.frame_fragments.size();
+	
+	tx_thread.reset();
+	ready_signal = false;
+	tx_thread = std::make_unique<ReplayThread>(
+		std::make_unique<FragmentsReader>(view_config.frame_fragments, repeat_min),
+		tx_read_size, tx_buffer_count,
+		&ready_signal,
+		nullptr
+	);
 
 	transmitter_model.set_sampling_rate(OOK_SAMPLERATE);
 	transmitter_model.set_rf_amp(true);
@@ -316,7 +328,8 @@ void EncodersView::start_tx(const bool scan) {
 		bitstream_length,
 		view_config.samples_per_bit(),
 		repeat_min,
-		view_config.pause_symbols()
+		view_config.pause_symbols(),
+		true
 	);
 }
 
@@ -26,6 +26,7 @@
 #include "transmitter_model.hpp"
 #include "encoders.hpp"
 #include "de_bruijn.hpp"
+#include "replay_thread.hpp"
 
 using namespace encoders;
 
@@ -173,6 +174,12 @@ private:
 	uint8_t repeat_index { 0 };
 	uint8_t repeat_min { 0 };
 	
+	// Frames are streamed to the baseband, double buffered
+	static constexpr size_t tx_read_size { 512 };
+	static constexpr size_t tx_buffer_count { 2 };
+	std::unique_ptr<ReplayThread> tx_thread { };
+	bool ready_signal { false };
+	
 	void update_progress();
 	void start_tx(const bool scan);
 	void on_tx_progress(const uint32_t progress, const bool done);
@@ -220,6 +227,16 @@ private:
 			this->on_tx_progress(message.progress, message.done);
 		}
 	};
+	
+	MessageHandlerRegistration message_handler_fifo_signal {
+		Message::ID::RequestSignal,
+		[this](const Message* const p) {
+			const auto message = static_cast<const RequestSignalMessage*>(p);
+			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+				ready_signal = true;
+			}
+		}
+	};
 };
 
 } /* namespace ui */
@@ -101,12 +101,17 @@ void GlassView::on_channel_spectrum(const ChannelSpectrum &spectrum)
 		}
 	}
 
-	if (pixel_index)
+	if (pixel_index) {
 		f_center += LOOKING_GLASS_SLICE_WIDTH; //Move into the next bandwidth slice NOTE: spectrum.sampling_rate = LOOKING_GLASS_SLICE_WIDTH
-	else
+		slice_index++;
+	} else {
 		f_center = f_center_ini; //Start a new sweep
+		slice_index = 0;
+	}
 
-	receiver_model.set_tuning_frequency(f_center); //tune rx for this slice
+	if (slice_index >= slice_plans.size())
+		slice_plans.push_back(receiver_model.tuning_plan(f_center)); //First sweep: keep this slice's synthesizer setup
+	receiver_model.set_tuning_frequency(f_center, slice_plans[slice_index]); //tune rx for this slice
 	baseband::spectrum_streaming_start();          //Do the RX
 }
 
@@ -151,6 +156,8 @@ void GlassView::on_range_changed()
 	PlotMarker(field_marker.value()); //Refresh marker on screen
 
 	f_center = f_center_ini;                        //Reset sweep into first slice
+	slice_index = 0;
+	slice_plans.clear();                            //Slices moved, plan them again
 	pixel_index = 0;                                //reset pixel counter
 	max_power = 0;
 	bins_Hz_size = 0;                               //reset amount of Hz filled up by pixels
@@ -253,10 +260,11 @@ GlassView::GlassView(
 	// it keeps adding the output of the fft to the buffer until "trigger" number of calls are made,
 	//at which time it pushes the buffer up with channel_spectrum.feed
 
-	on_range_changed();
-
 	receiver_model.set_modulation(ReceiverModel::Mode::SpectrumAnalysis);
 	receiver_model.set_sampling_rate(LOOKING_GLASS_SLICE_WIDTH); //20mhz
+
+	on_range_changed();
+
 	receiver_model.set_baseband_bandwidth(LOOKING_GLASS_SLICE_WIDTH); // possible values: 1.75/2.5/3.5/5/5.5/6/7/8/9/10/12/14/15/20/24/28MHz
 	receiver_model.set_squelch_level(0);
 	receiver_model.enable();
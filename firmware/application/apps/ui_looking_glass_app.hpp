@@ -84,6 +84,8 @@ namespace ui
 		rf::Frequency search_span { 0 };
 		rf::Frequency f_center { 0 };
 		rf::Frequency f_center_ini { 0 };
+		std::vector<radio::TuningPlan> slice_plans { };	// Filled in during the first sweep
+		size_t slice_index { 0 };
 		rf::Frequency marker_pixel_step { 0 };
 		rf::Frequency each_bin_size { LOOKING_GLASS_SLICE_WIDTH  / 240 };
 		rf::Frequency bins_Hz_size { 0 };
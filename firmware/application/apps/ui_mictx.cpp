@@ -66,7 +66,7 @@ void MicTXView::configure_baseband() {
 		transmitting ? transmitter_model.channel_bandwidth() : 0,
 		mic_gain,
 		TONES_F2D(tone_key_frequency(tone_key_index), sampling_rate),
-		100,0,0,
+		100,
 		mod_type
 	);
 }
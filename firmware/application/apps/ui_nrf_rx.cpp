@@ -54,7 +54,7 @@ NRFRxView::NRFRxView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&field_frequency,
-		&text_debug,
+		&options_rate,
 		&button_modem_setup,
 		&record_view,
 		&console
@@ -95,18 +95,25 @@ NRFRxView::NRFRxView(NavigationView& nav) {
 	};
 	
 	
-	// Auto-configure modem for LCR RX (will be removed later)
-	baseband::set_nrf(persistent_memory::modem_baudrate(), 8, 0, false);
-	
 	audio::set_rate(audio::Rate::Hz_24000);
 	audio::output::start();
 	
-	receiver_model.set_sampling_rate(4000000);
+	options_rate.on_change = [this](size_t, OptionsField::value_t v) {
+		set_rate(v);
+	};
+	options_rate.set_selected_index(0);		// 250k
+	
 	receiver_model.set_baseband_bandwidth(4000000);
 	receiver_model.set_modulation(ReceiverModel::Mode::WidebandFMAudio);
 	receiver_model.enable();
 }
 
+void NRFRxView::set_rate(const uint32_t rate) {
+	// 2M needs twice the sampling rate to keep one sample per symbol after decimation
+	receiver_model.set_sampling_rate((rate == 2000000) ? 8000000 : 4000000);
+	baseband::set_nrf(rate, 8, 0, false);
+}
+
 void NRFRxView::on_data(uint32_t value, bool is_data) {
 	//std::string str_console = "\x1B";
 	std::string str_console = "";
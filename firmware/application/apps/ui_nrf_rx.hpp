@@ -69,9 +69,14 @@ private:
 		{ 0 * 8, 0 * 16 },
 	};
 	
-	Text text_debug {
-		{ 0 * 8, 1 * 16, 10 * 8, 16 },
-		"DEBUG"
+	OptionsField options_rate {
+		{ 0 * 8, 1 * 16 },
+		4,
+		{
+			{ "250k", 250000 },
+			{ "1M  ", 1000000 },
+			{ "2M  ", 2000000 }
+		}
 	};
 	
 	
@@ -91,6 +96,7 @@ private:
 	};
 
 	void update_freq(rf::Frequency f);
+	void set_rate(const uint32_t rate);
 	//void on_data_afsk(const AFSKDataMessage& message);
 	
 	MessageHandlerRegistration message_handler_packet {
@@ -22,6 +22,10 @@
 
 #include "ui_scanner.hpp"
 #include "ui_fileman.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <algorithm>
+#include <cstdlib>
 
 using namespace portapack;
 
@@ -66,6 +70,15 @@ void ScannerThread::set_freq_del(const uint32_t v) {
 	_freq_del = v;
 }
 
+void ScannerThread::set_squelch(const int32_t v) {
+	_squelch = v;
+}
+
+void ScannerThread::set_measurement_window(const uint32_t settle_us, const uint32_t window_us) {
+	_settle_us = settle_us;
+	_window_us = window_us;
+}
+
 void ScannerThread::change_scanning_direction() {
 	_fwd = !_fwd;
 	chThdSleepMilliseconds(300);	//Give some pause after reversing scanning direction
@@ -78,11 +91,37 @@ msg_t ScannerThread::static_fn(void* arg) {
 	return 0;
 }
 
+int32_t ScannerThread::measure_channel() {
+	auto& measurement = shared_memory.scan_measurement;
+	measurement.settle_us = _settle_us;
+	measurement.window_us = _window_us;
+	const uint32_t id = measurement.request_id + 1;
+	measurement.request_id = id;
+
+	// Poll the answer: quiet channels never go through the event loop
+	for (uint32_t t = 0; t < SCAN_MEASUREMENT_TIMEOUT; t++) {
+		if (measurement.done_id == id)
+			return measurement.max_db;
+		chThdSleepMilliseconds(1);
+	}
+
+	return _squelch + 1;					//No answer (baseband busy or restarting): check it the slow way
+}
+
+void ScannerThread::update_tuning_plans() {
+	tuning_plans_offset_ = receiver_model.tuning_offset();
+	tuning_plans_.clear();
+	tuning_plans_.reserve(frequency_list_.size());
+	for (const auto frequency : frequency_list_)
+		tuning_plans_.push_back(receiver_model.tuning_plan(frequency));
+}
+
 void ScannerThread::run() {
 	if (frequency_list_.size())	{					//IF THERE IS A FREQUENCY LIST ...	
 		RetuneMessage message { };
 		uint32_t frequency_index = frequency_list_.size();
 		bool restart_scan = false;					//Flag whenever scanning is restarting after a pause
+		systime_t last_report = chTimeNow();
 		while( !chThdShouldTerminate() ) {
 			if (_scanning) {						//Scanning
 				if (_freq_lock == 0) {				//normal scanning (not performing freq_lock)
@@ -97,13 +136,26 @@ void ScannerThread::run() {
 								frequency_index = frequency_list_.size();	
 							frequency_index--;
 						}
-						receiver_model.set_tuning_frequency(frequency_list_[frequency_index]);	// Retune
+						if (tuning_plans_.size() != frequency_list_.size() || tuning_plans_offset_ != receiver_model.tuning_offset())
+							update_tuning_plans();		//First pass, or mode changed: precompute every synthesizer setting
+						receiver_model.set_tuning_frequency(frequency_list_[frequency_index], tuning_plans_[frequency_index]);	// Retune
+
+						if (measure_channel() <= _squelch) {	//Empty channel: move on right away
+							if (chTimeElapsedSince(last_report) >= MS2ST(SCAN_REPORT_INTERVAL)) {
+								last_report = chTimeNow();
+								message.range = frequency_index;	//Show progress now and then
+								EventDispatcher::send_message(message);
+							}
+							continue;
+						}
+						_freq_lock = 1;				//Activity: hold here, UI confirms it with the channel statistics
 					}
 					else
 						restart_scan=false;			//Effectively skipping first retuning, giving system time
 				} 
 				message.range = frequency_index;	//Inform freq (for coloring purposes also!)
 				EventDispatcher::send_message(message);
+				last_report = chTimeNow();
 			} 
 			else {									//NOT scanning 									
 				if (_freq_del != 0) {				//There is a frequency to delete
@@ -111,6 +163,8 @@ void ScannerThread::run() {
 						if (frequency_list_[i] == _freq_del) 
 						{							//found: Erase it
 							frequency_list_.erase(frequency_list_.begin() + i);
+							if (i < tuning_plans_.size())
+								tuning_plans_.erase(tuning_plans_.begin() + i);
 							if (i==0)				//set scan index one place back to compensate
 								i=frequency_list_.size();
 							else
@@ -130,15 +184,19 @@ void ScannerThread::run() {
 }
 
 void ScannerView::handle_retune(uint32_t i) {
+	if (survey_state == SurveyState::Narrowed)
+		i = survey_index;						//The narrowed thread only holds this one entry
+
 	switch (scan_thread->is_freq_lock())
 	{
 	case 0:										//NO FREQ LOCK, ONGOING STANDARD SCANNING
+	case 1:										//STARTING LOCK FREQ (the scanner thread stopped on activity)
 		text_cycle.set( to_string_dec_uint(i + 1,3) );
+		show_retune_time();
 		current_index = i;		//since it is an ongoing scan, this is a new index
 		if (description_list[current_index].size() > 0) desc_cycle.set( description_list[current_index] );	//Show new description	
-		break;
-	case 1:										//STARTING LOCK FREQ
-		big_display.set_style(&style_yellow);
+		if (scan_thread->is_freq_lock())
+			big_display.set_style(&style_yellow);
 		break;
 	case MAX_FREQ_LOCK:							//FREQ IS STRONG: GREEN and scanner will pause when on_statistics_update()
 		big_display.set_style(&style_green);
@@ -149,6 +207,14 @@ void ScannerView::handle_retune(uint32_t i) {
 	big_display.set(frequency_list[current_index]);	//UPDATE the big Freq after 0, 1 or MAX_FREQ_LOCK (at least, for color synching)
 }
 
+void ScannerView::show_retune_time() {	//Last hop time, fits left of the Load button
+	const auto us = radio::debug::retune_stats().last_us;
+	if (us < 1000)
+		text_retune.set(to_string_dec_uint(us, 3) + "us");
+	else
+		text_retune.set(to_string_dec_uint(std::min<uint32_t>(us / 1000, 999), 3) + "ms");
+}
+
 void ScannerView::focus() {
 	field_mode.focus();
 }
@@ -187,7 +253,9 @@ ScannerView::ScannerView(
 		&rssi,
 		&text_cycle,
 		&text_max,
+		&text_retune,
 		&desc_cycle,
+		&field_survey,
 		&big_display,
 		&button_manual_start,
 		&button_manual_end,
@@ -271,6 +339,18 @@ ScannerView::ScannerView(
 	};
 
 	button_remove.on_select = [this](Button&) {
+		if (survey_state != SurveyState::Off) {
+			if (frequency_list.size() > current_index) {
+				description_list.erase(description_list.begin() + current_index);
+				frequency_list.erase(frequency_list.begin() + current_index);
+				show_max();
+				desc_cycle.set(" ");
+			}
+			userpause = false;
+			button_pause.set_text("PAUSE");
+			survey_start();							//Slices change with the list
+			return;
+		}
 		if (frequency_list.size() > current_index) {
 			if (scan_thread->is_scanning())			//STOP Scanning if necessary
 				scan_thread->set_scanning(false);
@@ -318,6 +398,8 @@ ScannerView::ScannerView(
 	};
 
 	field_mode.on_change = [this](size_t, OptionsField::value_t v) {
+		if (survey_state == SurveyState::Surveying)
+			return;												//Applied when a channel gets narrowed
 		receiver_model.disable();
 		baseband::shutdown();
 		change_mode(v);
@@ -374,9 +456,21 @@ ScannerView::ScannerView(
 		}
 	};
 
+	field_survey.on_change = [this](size_t, OptionsField::value_t v) {
+		if (v)
+			survey_start();
+		else if (survey_state != SurveyState::Off)
+			survey_stop();
+	};
+
 	//PRE-CONFIGURATION:
 	field_wait.on_change = [this](int32_t v) {	wait = v;	}; 	field_wait.set_value(5);
-	field_squelch.on_change = [this](int32_t v) {	squelch = v;	}; 	field_squelch.set_value(-10);
+	field_squelch.on_change = [this](int32_t v) {
+		squelch = v;
+		if (scan_thread)
+			scan_thread->set_squelch(v);
+	};
+	field_squelch.set_value(-10);
 	field_volume.set_value((receiver_model.headphone_volume() - audio::headphone::volume_range().max).decibel() + 99);
 	field_volume.on_change = [this](int32_t v) { this->on_headphone_volume_changed(v);	};
 
@@ -448,6 +542,9 @@ void ScannerView::frequency_file_load(std::string file_name, bool stop_all_befor
 }
 
 void ScannerView::on_statistics_update(const ChannelStatistics& statistics) {
+	if (survey_state == SurveyState::Surveying)			//Wideband image: survey works from the spectrum
+		return;
+
 	if ( !userpause ) 									//Scanning not user-paused
 	{
 		if (timer >= (wait * 10) ) 
@@ -458,6 +555,7 @@ void ScannerView::on_statistics_update(const ChannelStatistics& statistics) {
 		else if (!timer) 
 		{
 			if (statistics.max_db > squelch ) {  		//There is something on the air...(statistics.max_db > -squelch) 
+				survey_quiet = 0;
 				if (scan_thread->is_freq_lock() >= MAX_FREQ_LOCK) { //checking time reached
 					scan_pause();
 					timer++;	
@@ -469,6 +567,8 @@ void ScannerView::on_statistics_update(const ChannelStatistics& statistics) {
 					big_display.set_style(&style_grey);	//Back to grey color
 					scan_thread->set_freq_lock(0); 		//Reset the scanner lock, since there is no signal
 				}				
+				if (survey_state == SurveyState::Narrowed && ++survey_quiet >= SURVEY_NARROW_HOLD)
+					survey_start();						//Gone before it could be confirmed: survey again
 			}
 		} 
 		else 	//Ongoing wait time
@@ -479,6 +579,10 @@ void ScannerView::on_statistics_update(const ChannelStatistics& statistics) {
 }
 
 void ScannerView::scan_pause() {
+	if (survey_state == SurveyState::Surveying) {
+		baseband::spectrum_streaming_stop();	//Sweep holds until user_resume()
+		return;
+	}
 	if (scan_thread->is_scanning()) {
 		scan_thread->set_freq_lock(0); 		//Reset the scanner lock (because user paused, or MAX_FREQ_LOCK reached) for next freq scan	
 		scan_thread->set_scanning(false); // WE STOP SCANNING
@@ -487,6 +591,10 @@ void ScannerView::scan_pause() {
 }
 
 void ScannerView::scan_resume() {
+	if (survey_state == SurveyState::Narrowed) {
+		survey_start();
+		return;
+	}
 	audio::output::stop();
 	big_display.set_style(&style_grey);		//Back to grey color
 	if (!scan_thread->is_scanning())
@@ -497,6 +605,8 @@ void ScannerView::user_resume() {
 	timer = wait * 10;					//Will trigger a scan_resume() on_statistics_update, also advancing to next freq.
 	button_pause.set_text("PAUSE");		//Show button for pause
 	userpause=false;					//Resume scanning
+	if (survey_state == SurveyState::Surveying)
+		baseband::spectrum_streaming_start();	//No statistics while surveying, restart the sweep here
 }
 
 void ScannerView::on_headphone_volume_changed(int32_t v) {
@@ -557,9 +667,154 @@ size_t ScannerView::change_mode(uint8_t new_mod) { //Before this, do a scan_thre
 }
 
 void ScannerView::start_scan_thread() {
+	if (survey_state != SurveyState::Off) {
+		survey_start();					//New list: plan the slices again
+		return;
+	}
 	receiver_model.enable(); 
 	receiver_model.set_squelch_level(0);
 	scan_thread = std::make_unique<ScannerThread>(frequency_list);
+	scan_thread->set_squelch(squelch);
+}
+
+void ScannerView::survey_plan() {
+	survey_order.resize(frequency_list.size());
+	for (size_t i = 0; i < survey_order.size(); i++)
+		survey_order[i] = i;
+	std::sort(survey_order.begin(), survey_order.end(), [this](const uint16_t a, const uint16_t b) {
+		return frequency_list[a] < frequency_list[b];
+	});
+
+	// Greedy: each slice starts with its lowest entry on the lower edge and takes
+	// every following entry it can see, that is not lost in the DC spike
+	survey_slices.clear();
+	for (size_t n = 0; n < survey_order.size(); n++) {
+		const rf::Frequency frequency = frequency_list[survey_order[n]];
+		if (!survey_slices.empty()) {
+			auto& slice = survey_slices.back();
+			const rf::Frequency offset = std::abs(frequency - slice.center);
+			if (offset >= (SURVEY_DC_BINS * SURVEY_BIN_WIDTH) && offset <= (SURVEY_EDGE_BINS * SURVEY_BIN_WIDTH)) {
+				slice.count++;
+				continue;
+			}
+		}
+		const rf::Frequency center = frequency + (SURVEY_EDGE_BINS * SURVEY_BIN_WIDTH);
+		survey_slices.push_back({ center, receiver_model.tuning_plan(center), (uint16_t)n, 1 });
+	}
+}
+
+void ScannerView::survey_start() {
+	scan_thread->stop();
+	audio::output::stop();
+	receiver_model.disable();
+	baseband::shutdown();
+	spectrum_fifo = nullptr;
+
+	survey_state = SurveyState::Surveying;
+	baseband::run_image(portapack::spi_flash::image_tag_wideband_spectrum);
+	receiver_model.set_modulation(ReceiverModel::Mode::SpectrumAnalysis);
+	receiver_model.set_sampling_rate(SURVEY_SLICE_WIDTH);
+	receiver_model.set_baseband_bandwidth(SURVEY_SLICE_WIDTH);
+	receiver_model.set_squelch_level(0);
+	survey_plan();					//After the mode change: plans carry the tuning offset
+	baseband::set_spectrum(SURVEY_SLICE_WIDTH, SURVEY_TRIGGER);
+	receiver_model.enable();
+
+	big_display.set_style(&style_grey);
+	text_max.set("/ " + to_string_dec_uint(survey_slices.size()) + " SLICES");
+	timer = 0;
+	survey_slice = 0;
+	survey_tune();
+}
+
+void ScannerView::survey_stop() {
+	baseband::spectrum_streaming_stop();
+	receiver_model.disable();
+	baseband::shutdown();
+	spectrum_fifo = nullptr;
+
+	survey_state = SurveyState::Off;
+	change_mode(field_mode.selected_index_value());
+	show_max();
+	timer = 0;
+	start_scan_thread();
+}
+
+void ScannerView::survey_tune() {
+	if (survey_slices.empty())
+		return;
+
+	const auto& slice = survey_slices[survey_slice];
+	receiver_model.set_tuning_frequency(slice.center, slice.tuning_plan);
+	text_cycle.set(to_string_dec_uint(survey_slice + 1, 3));
+	show_retune_time();
+	if (!userpause)
+		baseband::spectrum_streaming_start();
+}
+
+void ScannerView::survey_narrow(const size_t index) {
+	receiver_model.disable();
+	baseband::shutdown();
+	spectrum_fifo = nullptr;
+
+	survey_state = SurveyState::Narrowed;
+	survey_index = index;
+	survey_quiet = 0;
+	timer = 0;
+	change_mode(field_mode.selected_index_value());
+	receiver_model.enable();
+	receiver_model.set_squelch_level(0);
+
+	// The thread only holds this entry: it retunes, measures it and locks on it
+	scan_thread = std::make_unique<ScannerThread>(std::vector<rf::Frequency> { frequency_list[index] });
+	scan_thread->set_squelch(squelch);
+	current_index = index;
+	big_display.set_style(&style_yellow);
+	big_display.set(frequency_list[index]);
+}
+
+void ScannerView::on_survey_spectrum(const ChannelSpectrum& spectrum) {
+	if (survey_state != SurveyState::Surveying)
+		return;
+
+	baseband::spectrum_streaming_stop();
+
+	const auto& slice = survey_slices[survey_slice];
+
+	// Slice average, leaving out the edges and the DC spike
+	uint32_t sum = 0;
+	for (size_t k = SURVEY_DC_BINS; k <= SURVEY_EDGE_BINS; k++)
+		sum += spectrum.db[k] + spectrum.db[256 - k];
+	const int32_t average = sum / ((SURVEY_EDGE_BINS - SURVEY_DC_BINS + 1) * 2);
+
+	// Bin scale is 5 units per dB, 255 being full scale like the channel statistics
+	const int32_t threshold = std::max(255 + (squelch * 5), average + SURVEY_MIN_SNR);
+
+	int32_t best_level = threshold;
+	size_t best_index = frequency_list.size();
+	for (size_t n = slice.first; n < slice.first + slice.count; n++) {
+		const size_t index = survey_order[n];
+		const rf::Frequency offset = frequency_list[index] - slice.center;
+		const int32_t k = (offset + (offset < 0 ? -(SURVEY_BIN_WIDTH / 2) : (SURVEY_BIN_WIDTH / 2))) / SURVEY_BIN_WIDTH;
+		const int32_t level = spectrum.db[k & 0xff];			//Negative offsets are in the upper half
+		if (level > best_level) {
+			best_level = level;
+			best_index = index;
+		}
+	}
+
+	if (best_index < frequency_list.size()) {
+		if (description_list[best_index].size() > 0) desc_cycle.set( description_list[best_index] );
+		text_cycle.set( to_string_dec_uint(best_index + 1, 3) );
+		survey_narrow(best_index);
+		return;
+	}
+
+	survey_slice++;
+	if (survey_slice >= survey_slices.size())
+		survey_slice = 0;
+	big_display.set(slice.center);
+	survey_tune();
 }
 
-} /* namespace ui */
\ No newline at end of file
+} /* namespace ui */
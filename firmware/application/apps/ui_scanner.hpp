@@ -36,6 +36,15 @@
 
 #define MAX_DB_ENTRY 500
 #define MAX_FREQ_LOCK 10 		//50ms cycles scanner locks into freq when signal detected, to verify signal is not spureous
+#define SCAN_MEASUREMENT_TIMEOUT 50	//ms to wait for the baseband's channel power measurement
+#define SCAN_REPORT_INTERVAL 100	//ms between position updates to the UI while channels are quiet
+#define SURVEY_SLICE_WIDTH 20000000	//Hz covered by one wideband FFT in survey mode
+#define SURVEY_BIN_WIDTH (SURVEY_SLICE_WIDTH / 256)
+#define SURVEY_EDGE_BINS 120		//Usable bins each side of the slice center
+#define SURVEY_DC_BINS 6			//Bins around the slice center lost to the DC spike
+#define SURVEY_TRIGGER 31			//Wideband buffers summed into each survey FFT
+#define SURVEY_MIN_SNR 30			//Spectrum units (5 per dB) a channel must stand above its slice average
+#define SURVEY_NARROW_HOLD 10		//100ms statistics updates a narrowed channel may stay quiet before surveying again
 
 namespace ui {
 
@@ -57,6 +66,9 @@ public:
 
 	void set_freq_del(const uint32_t v);
 
+	void set_squelch(const int32_t v);
+	void set_measurement_window(const uint32_t settle_us, const uint32_t window_us);
+
 	void change_scanning_direction();
 
 	void stop();
@@ -68,14 +80,21 @@ public:
 
 private:
 	std::vector<rf::Frequency> frequency_list_ { };
+	std::vector<radio::TuningPlan> tuning_plans_ { };
+	int32_t tuning_plans_offset_ { 0 };
 	Thread* thread { nullptr };
 	
 	bool _scanning { true };
 	bool _fwd { true };
 	uint32_t _freq_lock { 0 };
 	uint32_t _freq_del { 0 };
+	int32_t _squelch { 0 };
+	uint32_t _settle_us { 2000 };			// Samples still in flight from the previous frequency
+	uint32_t _window_us { 3000 };			// Channel power measurement after settling
 	static msg_t static_fn(void* arg);
 	void run();
+	void update_tuning_plans();
+	int32_t measure_channel();
 };
 
 class ScannerView : public View {
@@ -123,6 +142,7 @@ private:
 	void start_scan_thread();
 	size_t change_mode(uint8_t mod_type);
 	void show_max();
+	void show_retune_time();
 	void scan_pause();
 	void scan_resume();
 	void user_resume();
@@ -132,6 +152,24 @@ private:
 	void on_headphone_volume_changed(int32_t v);
 	void handle_retune(uint32_t i);
 
+	// Survey mode: one wideband FFT checks every list entry inside its slice,
+	// the narrowband image only comes up for channels above squelch
+	enum class SurveyState { Off, Surveying, Narrowed };
+
+	struct survey_slice_t {
+		rf::Frequency center;
+		radio::TuningPlan tuning_plan;
+		uint16_t first;					//Into survey_order
+		uint16_t count;
+	};
+
+	void survey_plan();
+	void survey_start();
+	void survey_stop();
+	void survey_tune();
+	void survey_narrow(const size_t index);
+	void on_survey_spectrum(const ChannelSpectrum& spectrum);
+
 	jammer::jammer_range_t frequency_range { false, 0, 0 };  //perfect for manual scan task too...
 	int32_t squelch { 0 };
 	uint32_t timer { 0 };
@@ -141,10 +179,19 @@ private:
 	std::string loaded_file_name;
 	uint32_t current_index { 0 };
 	bool userpause { false };
+
+	SurveyState survey_state { SurveyState::Off };
+	std::vector<survey_slice_t> survey_slices { };
+	std::vector<uint16_t> survey_order { };		//frequency_list indexes, by frequency
+	size_t survey_slice { 0 };
+	size_t survey_index { 0 };					//Entry narrowed to
+	uint32_t survey_quiet { 0 };
+	ChannelSpectrumFIFO* spectrum_fifo { nullptr };
 	
 	Labels labels {
 		{ { 0 * 8, 0 * 16 }, "LNA:   VGA:   AMP:  VOL:", Color::light_grey() },
 		{ { 0 * 8, 1* 16 }, "BW:    SQUELCH:   db WAIT:", Color::light_grey() },
+		{ { 0 * 8, 5 * 16 }, "SURVEY:", Color::light_grey() },
 		{ { 3 * 8, 10 * 16 }, "START        END     MANUAL", Color::light_grey() },
 		{ { 0 * 8, (26 * 8) + 4 }, "MODE:", Color::light_grey() },
 		{ { 11 * 8, (26 * 8) + 4 }, "STEP:", Color::light_grey() },
@@ -201,13 +248,26 @@ private:
 	};
 
 	Text text_max {
-		{ 4 * 8, 3 * 16, 18 * 8, 16 },  
+		{ 4 * 8, 3 * 16, 15 * 8, 16 },  
+	};
+
+	Text text_retune {
+		{ 19 * 8, 3 * 16, 5 * 8, 16 },
 	};
 	
 	Text desc_cycle {
 		{0, 4 * 16, 240, 16 },	   
 	};
 
+	OptionsField field_survey {
+		{ 8 * 8, 5 * 16 },
+		3,
+		{
+			{ "OFF", 0 },
+			{ "FFT", 1 },
+		}
+	};
+
 	BigFrequency big_display {		//Show frequency in glamour
 		{ 4, 6 * 16, 28 * 8, 52 },
 		0
@@ -306,6 +366,26 @@ private:
 			this->on_statistics_update(static_cast<const ChannelStatisticsMessage*>(p)->statistics);
 		}
 	};
+
+	MessageHandlerRegistration message_handler_spectrum_config {
+		Message::ID::ChannelSpectrumConfig,
+		[this](const Message* const p) {
+			const auto message = *reinterpret_cast<const ChannelSpectrumConfigMessage*>(p);
+			if( this->survey_state == SurveyState::Surveying )
+				this->spectrum_fifo = message.fifo;
+		}
+	};
+
+	MessageHandlerRegistration message_handler_frame_sync {
+		Message::ID::DisplayFrameSync,
+		[this](const Message* const) {
+			ChannelSpectrum channel_spectrum;
+			// Narrowing to a channel drops the FIFO along with the wideband image
+			while( this->spectrum_fifo && this->spectrum_fifo->out(channel_spectrum) ) {
+				this->on_survey_spectrum(channel_spectrum);
+			}
+		}
+	};
 };
 
 } /* namespace ui */
\ No newline at end of file
@@ -229,7 +229,7 @@ void SearchView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
 			slice_counter = 0;
 		} else
 			slice_counter++;
-		receiver_model.set_tuning_frequency(slices[slice_counter].center_frequency);
+		receiver_model.set_tuning_frequency(slices[slice_counter].center_frequency, slices[slice_counter].tuning_plan);
 		baseband::set_spectrum(SEARCH_SLICE_WIDTH, 31);	// Clear
 	} else {
 		// Unique slice
@@ -275,6 +275,7 @@ void SearchView::on_range_changed() {
 		
 		for (slice = 0; slice < slices_nb; slice++) {
 			slices[slice].center_frequency = center_frequency;
+			slices[slice].tuning_plan = receiver_model.tuning_plan(center_frequency);
 			center_frequency += SEARCH_SLICE_WIDTH;
 		}
 	} else {
@@ -424,10 +425,11 @@ SearchView::SearchView(
 	
 	progress_timers.set_max(DETECT_DELAY);
 	
-	on_range_changed();
-
 	receiver_model.set_modulation(ReceiverModel::Mode::SpectrumAnalysis);
 	receiver_model.set_sampling_rate(SEARCH_SLICE_WIDTH);
+
+	on_range_changed();
+
 	receiver_model.set_baseband_bandwidth(2500000);
 	receiver_model.enable();
 }
@@ -110,7 +110,8 @@ private:
 		int16_t max_index;
 		uint8_t power;
 		int16_t index;
-	} slices[32];
+		radio::TuningPlan tuning_plan;
+	} slices[32] { };
 	
 	uint32_t bin_skip_acc { 0 }, bin_skip_frac { };
 	uint32_t pixel_index { 0 };
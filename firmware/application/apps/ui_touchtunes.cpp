@@ -37,11 +37,13 @@ void TouchTunesView::focus() {
 }
 
 TouchTunesView::~TouchTunesView() {
+	tx_thread.reset();
 	transmitter_model.disable();
 	baseband::shutdown();
 }
 
 void TouchTunesView::stop_tx() {
+	tx_thread.reset();
 	transmitter_model.disable();
 	tx_mode = IDLE;
 	progressbar.set_value(0);
@@ -63,6 +65,7 @@ void TouchTunesView::on_tx_progress(const uint32_t progress, const bool done) {
 			if (pin == TOUCHTUNES_MAX_PIN) {
 				stop_tx();
 			} else {
+				tx_thread.reset();
 				transmitter_model.disable();
 				pin++;
 				field_pin.set_value(pin);
@@ -111,7 +114,16 @@ void TouchTunesView::start_tx(const uint32_t button_index) {
 	// Sync and end pulse
 	fragments = "111111111111111100000000" + fragments + "1000";
 	
-	size_t bitstream_length = make_bitstream(fragments);
+	const size_t bitstream_length = fragments.size();
+	
+	tx_thread.reset();
+	ready_signal = false;
+	tx_thread = std::make_unique<ReplayThread>(
+		std::make_unique<FragmentsReader>(std::move(fragments), TOUCHTUNES_REPEATS),
+		tx_read_size, tx_buffer_count,
+		&ready_signal,
+		nullptr
+	);
 	
 	transmitter_model.set_tuning_frequency(433920000);
 	transmitter_model.set_sampling_rate(OOK_SAMPLERATE);
@@ -123,7 +135,8 @@ void TouchTunesView::start_tx(const uint32_t button_index) {
 		bitstream_length,
 		OOK_SAMPLERATE / 1766,	// 560us
 		TOUCHTUNES_REPEATS,
-		100						// Pause
+		100,					// Pause
+		true
 	);
 }
 
@@ -24,6 +24,7 @@
 #include "ui.hpp"
 #include "ui_transmitter.hpp"
 #include "transmitter_model.hpp"
+#include "replay_thread.hpp"
 
 // The coding in notpike's script is quite complex, using multiple LUTs to form the data sent to the YSO.
 // The format is actually very simple if it is rather seen as short and long gaps between pulses (as seen in many OOK remotes).
@@ -124,6 +125,12 @@ private:
 	
 	tx_modes tx_mode = IDLE;
 	
+	// Frames are streamed to the baseband, double buffered
+	static constexpr size_t tx_read_size { 512 };
+	static constexpr size_t tx_buffer_count { 2 };
+	std::unique_ptr<ReplayThread> tx_thread { };
+	bool ready_signal { false };
+	
 	void start_tx(const uint32_t button_index);
 	void stop_tx();
 	void on_tx_progress(const uint32_t progress, const bool done);
@@ -212,6 +219,16 @@ private:
 			this->on_tx_progress(message.progress, message.done);
 		}
 	};
+	
+	MessageHandlerRegistration message_handler_fifo_signal {
+		Message::ID::RequestSignal,
+		[this](const Message* const p) {
+			const auto message = static_cast<const RequestSignalMessage*>(p);
+			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+				ready_signal = true;
+			}
+		}
+	};
 };
 
 } /* namespace ui */
@@ -37,16 +37,20 @@ void ViewWavView::update_scale(int32_t new_scale) {
 }
 
 void ViewWavView::refresh_waveform() {
+	wav_peaks->read(position, scale, peaks, 240);
+	
+	// Each pixel gets a vertical min/max stroke
 	for (size_t i = 0; i < 240; i++) {
-		wav_reader->data_seek(position + (i * scale));
-		wav_reader->read(&waveform_buffer[i], sizeof(int16_t));
+		waveform_buffer[i * 2] = peaks[i].min << 8;
+		waveform_buffer[i * 2 + 1] = peaks[i].max << 8;
 	}
 	
 	waveform.set_dirty();
 	
 	// Window
-	uint64_t w_start = (position * 240) / wav_reader->sample_count();
-	uint64_t w_width = (scale * 240) / (wav_reader->sample_count() / 240);
+	const uint64_t sample_count = std::max<uint64_t>(wav_reader->sample_count(), 1);
+	uint64_t w_start = std::min<uint64_t>((position * 240) / sample_count, 239);
+	uint64_t w_width = std::min<uint64_t>(((uint64_t)scale * 240 * 240) / sample_count, 239 - w_start);
 	display.fill_rectangle({ 0, 10 * 16 + 1, 240, 16 }, Color::black());
 	display.fill_rectangle({ (Coord)w_start, 21 * 8, (Dim)w_width + 1, 8 }, Color::white());
 	display.draw_line({ 0, 10 * 16 + 1 }, { (Coord)w_start, 21 * 8 }, Color::white());
@@ -78,33 +82,23 @@ void ViewWavView::on_pos_changed() {
 }
 
 void ViewWavView::load_wav(std::filesystem::path file_path) {
-	int16_t sample;
-	uint32_t average;
-
-	
 	text_filename.set(file_path.filename().string());
 	auto ms_duration = wav_reader->ms_duration();
 	text_duration.set(unit_auto_scale(ms_duration, 2, 3) + "s");
 	
-	wav_reader->rewind();
-	
 	text_samplerate.set(to_string_dec_uint(wav_reader->sample_rate()) + "Hz");
 	text_title.set(wav_reader->title());
 	
-	// Fill amplitude buffer, world's worst downsampling
-	uint64_t skip = wav_reader->sample_count() / (240 * subsampling_factor);
+	// First load of a file builds its peaks sidecar, later ones only read it
+	wav_peaks = std::make_unique<WAVPeaks>();
+	wav_peaks->open(*wav_reader, file_path);
 	
-	for (size_t i = 0; i < 240; i++) {
-		average = 0;
-		
-		for (size_t s = 0; s < subsampling_factor; s++) {
-			wav_reader->data_seek(((i * subsampling_factor) + s) * skip);
-			wav_reader->read(&sample, 2);
-			average += (abs(sample) >> 8);
-		}
-		
-		amplitude_buffer[i] = average / subsampling_factor;
-	}
+	// Fill amplitude buffer from the whole file's envelope
+	const uint32_t samples_per_peak = (wav_reader->sample_count() + 239) / 240;
+	wav_peaks->read(0, samples_per_peak, peaks, 240);
+	
+	for (size_t i = 0; i < 240; i++)
+		amplitude_buffer[i] = std::min(std::max(-peaks[i].min, (int)peaks[i].max), 127);
 	
 	reset_controls();
 	update_scale(1);
@@ -147,8 +141,8 @@ ViewWavView::ViewWavView(
 		nav_.display_modal("Error", "Couldn't open file.", INFO, nullptr);
 		return;
 	}
-	if ((wav_reader->channels() != 1) || (wav_reader->bits_per_sample() != 16)) {
-		nav_.display_modal("Error", "Wrong format.\nWav viewer only accepts\n16-bit mono files.", INFO, nullptr);
+	if ((wav_reader->channels() != 1) || ((wav_reader->bits_per_sample() != 8) && (wav_reader->bits_per_sample() != 16))) {
+		nav_.display_modal("Error", "Wrong format.\nWav viewer only accepts\n8 or 16-bit mono files.", INFO, nullptr);
 		return;
 	}
 			load_wav(file_path);
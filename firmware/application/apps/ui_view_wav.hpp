@@ -23,6 +23,7 @@
 #include "ui.hpp"
 #include "ui_navigation.hpp"
 #include "io_wave.hpp"
+#include "wav_peaks.hpp"
 #include "spectrum_color_lut.hpp"
 
 namespace ui {
@@ -38,7 +39,6 @@ public:
 
 private:
 	NavigationView& nav_;
-	static constexpr uint32_t subsampling_factor = 8;
 	
 	void update_scale(int32_t new_scale);
 	void refresh_waveform();
@@ -48,8 +48,10 @@ private:
 	void reset_controls();
 
 	std::unique_ptr<WAVFileReader> wav_reader { };
+	std::unique_ptr<WAVPeaks> wav_peaks { };
 	
-	int16_t waveform_buffer[240] { };
+	WAVPeaks::Peak peaks[240] { };
+	int16_t waveform_buffer[480] { };	// Min/max pairs, one per pixel
 	uint8_t amplitude_buffer[240] { };
 	int32_t scale { 1 };
 	uint64_t ns_per_pixel { };
@@ -60,7 +62,7 @@ private:
 		{ { 0 * 8, 1 * 16 }, "Samplerate:", Color::light_grey() },
 		{ { 0 * 8, 2 * 16 }, "Title:", Color::light_grey() },
 		{ { 0 * 8, 3 * 16 }, "Duration:", Color::light_grey() },
-		{ { 0 * 8, 11 * 16 }, "Position:   s         Scale:", Color::light_grey() },
+		{ { 0 * 8, 11 * 16 }, "Position:   s        Zoom:", Color::light_grey() },
 		{ { 0 * 8, 12 * 16 }, "Cursor A:", Color::dark_cyan() },
 		{ { 0 * 8, 13 * 16 }, "Cursor B:", Color::dark_magenta() },
 		{ { 0 * 8, 14 * 16 }, "Delta:", Color::light_grey() }
@@ -90,7 +92,7 @@ private:
 	Waveform waveform {
 		{ 0, 5 * 16, 240, 64 },
 		waveform_buffer,
-		240,
+		480,
 		0,
 		false,
 		Color::white()
@@ -111,9 +113,9 @@ private:
 		'0'
 	};
 	NumberField field_scale {
-		{ 28 * 8, 11 * 16 },
-		2,
-		{ 1, 40 },
+		{ 26 * 8, 11 * 16 },
+		4,
+		{ 1, 9999 },
 		1,
 		' '
 	};
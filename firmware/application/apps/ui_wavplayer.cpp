@@ -85,15 +85,13 @@ void WavPlayerView::start_play() {
 		transmitter_model.channel_bandwidth(),
 		0,	// Gain is unused
 		0,
-		field_speed.value(),
-		bit_type,
-		channels
+		field_speed.value()
 	);
 	baseband::set_sample_rate(sample_rate);
 	// Put replay thread to be initialized at last. maybe meaningful.
 
 	replay_thread = std::make_unique<ReplayThread>(
-		std::move(wav_reader),
+		std::make_unique<WAVStreamReader>(std::move(wav_reader)),
 		read_size, buffer_count,
 		&ready_signal,
 		[](uint32_t return_code) {
@@ -120,14 +118,13 @@ void WavPlayerView::load_wav(std::filesystem::path file_path) {
 	text_bits.set(to_string_dec_int(wav_reader->bits_per_sample()));
 	text_channels.set(to_string_dec_int(wav_reader->channels()));
 	sample_rate = wav_reader->sample_rate();
-	bit_type = wav_reader->bits_per_sample() == 8 ? 0 : 1;
-	channels = wav_reader->channels() - 1;
 
 	button_playpause.hidden(false);
 	check_loop.hidden(false);
 
 	text_cur_pos.set("0");
-	progressbar.set_max(wav_reader->sample_count() * (bit_type ? 2 : 1));
+	// Baseband progress is in bytes of the 16-bit mono stream
+	progressbar.set_max(wav_reader->sample_count() / wav_reader->channels() * 2);
 
 	button_playpause.focus();
 }
@@ -135,7 +132,7 @@ void WavPlayerView::load_wav(std::filesystem::path file_path) {
 
 void WavPlayerView::on_tx_progress(const uint32_t progress) {
 	progressbar.set_value(progress);
-	text_cur_pos.set(to_string_time_ms(progress / ((sample_rate / 1000) * (bit_type ? 2 : 1) * (channels + 1))));
+	text_cur_pos.set(to_string_time_ms(progress / ((sample_rate / 1000) * 2)));
 }
 
 WavPlayerView::WavPlayerView(
@@ -46,16 +46,14 @@ public:
 private:
 	NavigationView& nav_;
 
-	const size_t read_size { 2048 };	// Less ?
-	const size_t buffer_count { 3 };
+	const size_t read_size { 4096 };	// 16-bit mono after conversion
+	const size_t buffer_count { 4 };
 	std::unique_ptr<ReplayThread> replay_thread { };
 	bool ready_signal { false };
 	std::filesystem::path soundfile_path { };
 
 
 	uint32_t sample_rate { 0 };
-	uint8_t bit_type { 0 }; // 0 - 8bit, 1 - 16bit
-	uint8_t channels { 0 }; // 0 - 1 ch, 1 - 2ch
 
 	std::unique_ptr<WAVFileReader> wav_reader { };
 
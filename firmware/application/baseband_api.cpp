@@ -35,25 +35,51 @@ using namespace portapack;
 
 namespace baseband {
 
-static void send_message(const Message* const message) {
-	// If message is only sent by this function via one thread, no need to check if
-	// another message is present before setting new message.
-	shared_memory.baseband_message = message;
-	creg::m0apptxevent::assert_event();
-	while(shared_memory.baseband_message);
+/* Messages are copied into shared_memory.baseband_queue, so senders don't
+ * wait on the M4 unless they need its answer. The token returned by
+ * send_message() is the message's position in the queue: it is handled once
+ * shared_memory.baseband_completed reaches it.
+ */
+using token_t = uint32_t;
+
+static constexpr size_t completion_spin_count = 1000;
+
+static MUTEX_DECL(send_mutex);
+
+template<typename T>
+static token_t send_message(const T& message) {
+	chMtxLock(&send_mutex);
+	const token_t token = shared_memory.baseband_queued + 1;
+	shared_memory.baseband_queued = token;
+	while( !shared_memory.baseband_queue.push(message) ) {
+		// Queue full, let the M4 catch up
+		chThdSleepMilliseconds(1);
+	}
+	chMtxUnlock();
+	return token;
+}
+
+static bool is_completed(const token_t token) {
+	return static_cast<int32_t>(shared_memory.baseband_completed - token) >= 0;
+}
+
+static void wait_for_completion(const token_t token) {
+	// Usually done within a few microseconds, only sleep if it takes longer
+	for(size_t i=0; !is_completed(token); i++) {
+		if( i >= completion_spin_count ) {
+			chThdSleepMilliseconds(1);
+		}
+	}
 }
 
 void AMConfig::apply(const uint8_t spec_zoom) const {
 	const AMConfigureMessage message {
-		taps_6k0_decim_0,
-		taps_6k0_decim_1,
-		taps_6k0_decim_2,
 		channel,
 		modulation,
 		audio_12k_hpf_300hz_config,
 		spec_zoom
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_12000);
 }
 
@@ -68,7 +94,7 @@ void NBFMConfig::apply(const uint8_t squelch_level) const {
 		audio_24k_deemph_300_6_config,
 		squelch_level
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_24000);
 }
 
@@ -83,7 +109,7 @@ void WFMConfig::apply(iir_biquad_config_t deemph_config, uint8_t aspec_type, uin
 		aspec_type,
 		aspec_win
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_48000);
 }
 
@@ -101,7 +127,7 @@ void set_tones_config(const uint32_t bw, const uint32_t pre_silence, const uint1
 		dual_tone,
 		audio_out
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void kill_tone() {
@@ -112,7 +138,7 @@ void kill_tone() {
 		false,
 		false
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_sstv_data(const uint8_t vis_code, const uint32_t pixel_duration) {
@@ -120,35 +146,35 @@ void set_sstv_data(const uint8_t vis_code, const uint32_t pixel_duration) {
 		vis_code,
 		pixel_duration
 	};
-	send_message(&message);
+	send_message(message);
 }
 
-void set_afsk(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
+void set_afsk(const uint32_t baudrate, const uint32_t word_length, const bool hdlc) {
 	const AFSKRxConfigureMessage message {
 		baudrate,
 		word_length,
-		trigger_value,
-		trigger_word
+		hdlc
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_aprs(const uint32_t baudrate) {
 	const APRSRxConfigureMessage message {
 		baudrate
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 
-void set_btle(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
+void set_btle(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word, const uint8_t channel_number) {
 	const BTLERxConfigureMessage message {
 		baudrate,
 		word_length,
 		trigger_value,
-		trigger_word
+		trigger_word,
+		channel_number
 	};
-	send_message(&message);
+	send_message(message);
 }
     
 void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
@@ -158,7 +184,7 @@ void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t
 		trigger_value,
 		trigger_word
 	};
-	send_message(&message);
+	send_message(message);
 }
     
 void set_afsk_data(const uint32_t afsk_samples_per_bit, const uint32_t afsk_phase_inc_mark, const uint32_t afsk_phase_inc_space,
@@ -171,7 +197,7 @@ void set_afsk_data(const uint32_t afsk_samples_per_bit, const uint32_t afsk_phas
 		afsk_bw,
 		symbol_count
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void kill_afsk() {
@@ -183,11 +209,11 @@ void kill_afsk() {
 		0,
 		false
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_audiotx_config(const uint32_t divider, const float deviation_hz, const float audio_gain,
-					const uint32_t tone_key_delta, const uint16_t speed, const uint8_t bit_type, const uint8_t channels, const uint8_t mod_type) {
+					const uint32_t tone_key_delta, const uint16_t speed, const uint8_t mod_type) {
 	const AudioTXConfigMessage message {
 		divider,
 		deviation_hz,
@@ -195,18 +221,17 @@ void set_audiotx_config(const uint32_t divider, const float deviation_hz, const
 		tone_key_delta,
 		(float)persistent_memory::tone_mix() / 100.0f,
 		speed,
-		bit_type,
-		channels,
 		mod_type
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_fifo_data(const int8_t * data) {
 	const FIFODataMessage message {
 		data
 	};
-	send_message(&message);
+	// The M4 copies from the M0's buffer, which has to stay put until then
+	wait_for_completion(send_message(message));
 }
 
 void set_pitch_rssi(int32_t avg, bool enabled) {
@@ -214,18 +239,19 @@ void set_pitch_rssi(int32_t avg, bool enabled) {
 		enabled,
 		avg
 	};
-	send_message(&message);	
+	send_message(message);	
 }
 
 void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint8_t repeat,
-					const uint32_t pause_symbols) {
+					const uint32_t pause_symbols, const bool streamed) {
 	const OOKConfigureMessage message {
 		stream_length,
 		samples_per_bit,
 		repeat,
-		pause_symbols
+		pause_symbols,
+		streamed
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint32_t shift,
@@ -236,7 +262,7 @@ void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit,
 		shift,
 		progress_notice
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_pocsag(const pocsag::BitRate bitrate, bool phase) {
@@ -244,14 +270,22 @@ void set_pocsag(const pocsag::BitRate bitrate, bool phase) {
 		bitrate,
 		phase
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_adsb() {
 	const ADSBConfigureMessage message {
 		1
 	};
-	send_message(&message);
+	send_message(message);
+}
+
+void set_acars(const std::array<int32_t, ACARSConfigureMessage::max_channels>& channel_offsets, const size_t channel_count) {
+	const ACARSConfigureMessage message {
+		channel_offsets,
+		channel_count
+	};
+	send_message(message);
 }
 
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed) {
@@ -260,42 +294,42 @@ void set_jammer(const bool run, const jammer::JammerType type, const uint32_t sp
 		type,
 		speed
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_rds_data(const uint16_t message_length) {
 	const RDSConfigureMessage message {
 		message_length
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_spectrum(const size_t sampling_rate, const size_t trigger, const uint8_t gain) {
 	const WidebandSpectrumConfigMessage message {
 		sampling_rate, trigger, gain
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_spectrum(const size_t sampling_rate, const size_t trigger) {
 	const WidebandSpectrumConfigMessage message {
 		sampling_rate, trigger, 0
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_siggen_tone(const uint32_t tone) {
 	const SigGenToneMessage message {
 		TONES_F2D(tone, TONES_SAMPLERATE)
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration, uint8_t mod_type) {
 	const SigGenConfigMessage message {
 		bw, shape, duration * TONES_SAMPLERATE, mod_type
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 static bool baseband_image_running = false;
@@ -307,6 +341,9 @@ void run_image(const portapack::spi_flash::image_tag_t image_tag) {
 
 	creg::m4txevent::clear();
 
+	shared_memory.baseband_queue.reset();
+	shared_memory.baseband_completed = shared_memory.baseband_queued;
+
 	m4_init(image_tag, portapack::memory::map::m4_code);
 	baseband_image_running = true;
 
@@ -321,7 +358,7 @@ void shutdown() {
 	creg::m4txevent::disable();
 
 	ShutdownMessage message;
-	send_message(&message);
+	wait_for_completion(send_message(message));
 
 	shared_memory.application_queue.reset();
 	
@@ -332,44 +369,44 @@ void spectrum_streaming_start() {
 	SpectrumStreamingConfigMessage message {
 		SpectrumStreamingConfigMessage::Mode::Running
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void spectrum_streaming_stop() {
 	SpectrumStreamingConfigMessage message {
 		SpectrumStreamingConfigMessage::Mode::Stopped
 	};
-	send_message(&message);
+	wait_for_completion(send_message(message));
 }
 
 void set_sample_rate(const uint32_t sample_rate) {
 	SamplerateConfigMessage message { sample_rate };
-	send_message(&message);
+	send_message(message);
 }
 
 void capture_start(CaptureConfig* const config) {
 	CaptureConfigMessage message { config };
-	send_message(&message);
+	wait_for_completion(send_message(message));
 }
 
 void capture_stop() {
 	CaptureConfigMessage message { nullptr };
-	send_message(&message);
+	wait_for_completion(send_message(message));
 }
 
 void replay_start(ReplayConfig* const config) {
 	ReplayConfigMessage message { config };
-	send_message(&message);
+	wait_for_completion(send_message(message));
 }
 
 void replay_stop() {
 	ReplayConfigMessage message { nullptr };
-	send_message(&message);
+	wait_for_completion(send_message(message));
 }
 
 void request_beep() {
 	RequestSignalMessage message { RequestSignalMessage::Signal::BeepRequest };
-	send_message(&message);
+	send_message(message);
 }
 
 } /* namespace baseband */
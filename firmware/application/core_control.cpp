@@ -28,9 +28,54 @@ using namespace lpc43xx;
 
 #include "message.hpp"
 #include "baseband_api.hpp"
+#include "lz4.hpp"
 
 #include <cstring>
 
+using namespace portapack::spi_flash;
+
+static debug::ImageLoadStats image_load_statistics { };
+
+static const chunk_t* find_chunk(const image_tag_t image_tag) {
+	const auto first = reinterpret_cast<const chunk_t*>(images.base());
+
+	if( first->tag == image_tag_directory ) {
+		const auto entries = reinterpret_cast<const directory_entry_t*>(&first->data[0]);
+		const size_t count = first->stored_length() / sizeof(directory_entry_t);
+		for(size_t i=0; i<count; i++) {
+			if( entries[i].tag == image_tag ) {
+				return reinterpret_cast<const chunk_t*>(reinterpret_cast<uint32_t>(images.base()) + entries[i].offset);
+			}
+		}
+		return nullptr;
+	}
+
+	// Images built without a directory
+	for(auto chunk = first; chunk->tag; chunk = chunk->next()) {
+		if( chunk->tag == image_tag ) {
+			return chunk;
+		}
+	}
+	return nullptr;
+}
+
+static size_t load_chunk(const chunk_t* const chunk, const portapack::memory::region_t to) {
+	if( chunk->is_compressed() ) {
+		const auto header = reinterpret_cast<const compressed_header_t*>(&chunk->data[0]);
+		const auto image_length = lz4::decompress_block(
+			&chunk->data[sizeof(compressed_header_t)], header->block_length,
+			reinterpret_cast<uint8_t*>(to.base()), to.size()
+		);
+		return (image_length == header->image_length) ? image_length : 0;
+	} else {
+		if( chunk->length > to.size() ) {
+			return 0;
+		}
+		std::memcpy(reinterpret_cast<void*>(to.base()), &chunk->data[0], chunk->length);
+		return chunk->length;
+	}
+}
+
 /* TODO: OK, this is cool, but how do I put the M4 to sleep so I can switch to
  * a different image? Other than asking the old image to sleep while the M0
  * makes changes?
@@ -38,27 +83,36 @@ using namespace lpc43xx;
  * I suppose I could force M4MEMMAP to an invalid memory reason which would
  * cause an exception and effectively halt the M4. But that feels gross.
  */
-void m4_init(const portapack::spi_flash::image_tag_t image_tag, const portapack::memory::region_t to) {
-	const portapack::spi_flash::chunk_t* chunk = reinterpret_cast<const portapack::spi_flash::chunk_t*>(portapack::spi_flash::images.base());
-	while(chunk->tag) {
-		if( chunk->tag == image_tag ) {
-			/* Initialize M4 code RAM */
-			std::memcpy(reinterpret_cast<void*>(to.base()), &chunk->data[0], chunk->length);
+void m4_init(const image_tag_t image_tag, const portapack::memory::region_t to) {
+	const auto start = halGetCounterValue();
 
-			/* M4 core is assumed to be sleeping with interrupts off, so we can mess
-			 * with its address space and RAM without concern.
-			 */
-			LPC_CREG->M4MEMMAP = to.base();
+	const auto chunk = find_chunk(image_tag);
+	if( !chunk ) {
+		chDbgPanic("NoImg");
+	}
 
-			/* Reset M4 core */
-			LPC_RGU->RESET_CTRL[0] = (1 << 13);
+	/* Initialize M4 code RAM */
+	const auto image_length = load_chunk(chunk, to);
+	if( !image_length ) {
+		chDbgPanic("BadImg");
+	}
 
-			return;
-		}
-		chunk = chunk->next();
+	const uint32_t us = uint64_t(halGetCounterValue() - start) * 1000000U / halGetCounterFrequency();
+	image_load_statistics.count++;
+	image_load_statistics.stored_bytes = chunk->stored_length();
+	image_load_statistics.image_bytes = image_length;
+	image_load_statistics.last_us = us;
+	if( us > image_load_statistics.max_us ) {
+		image_load_statistics.max_us = us;
 	}
 
-	chDbgPanic("NoImg");
+	/* M4 core is assumed to be sleeping with interrupts off, so we can mess
+	 * with its address space and RAM without concern.
+	 */
+	LPC_CREG->M4MEMMAP = to.base();
+
+	/* Reset M4 core */
+	LPC_RGU->RESET_CTRL[0] = (1 << 13);
 }
 
 void m4_request_shutdown() {
@@ -71,3 +125,11 @@ void m0_halt() {
 		port_wait_for_interrupt();
 	}
 }
+
+namespace debug {
+
+ImageLoadStats image_load_stats() {
+	return image_load_statistics;
+}
+
+} /* namespace debug */
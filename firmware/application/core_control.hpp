@@ -32,4 +32,21 @@ void m4_request_shutdown();
 
 void m0_halt();
 
+namespace debug {
+
+/* Time spent finding and copying (or decompressing) the last M4 image, to
+ * compare flash layouts and app switch times.
+ */
+struct ImageLoadStats {
+	uint32_t count;
+	uint32_t stored_bytes;
+	uint32_t image_bytes;
+	uint32_t last_us;
+	uint32_t max_us;
+};
+
+ImageLoadStats image_load_stats();
+
+} /* namespace debug */
+
 #endif/*__CORE_CONTROL_H__*/
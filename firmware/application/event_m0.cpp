@@ -76,6 +76,14 @@ public:
 	}
 
 	void send(Message* const message) {
+		if( message->id == Message::ID::PacketBatch ) {
+			auto& batch = *reinterpret_cast<PacketBatchMessage*>(message);
+			for(const auto packet : batch) {
+				send(packet);
+			}
+			return;
+		}
+
 		if( message->id < Message::ID::MAX ) {
 			auto& fn = map_[toUType(message->id)];
 			if( fn ) {
@@ -90,6 +98,7 @@ private:
 };
 
 static MessageHandlerMap message_map;
+static std::array<EventDispatcher::EventStats, EventDispatcher::event_count> event_statistics { };
 Thread* EventDispatcher::thread_event_loop = nullptr;
 bool EventDispatcher::is_running = false;
 bool EventDispatcher::display_sleep = false;
@@ -135,6 +144,27 @@ void EventDispatcher::set_display_sleep(const bool sleep) {
 	EventDispatcher::display_sleep = sleep;
 };
 
+EventDispatcher::EventStats EventDispatcher::event_stats(const Event event) {
+	return event_statistics[toUType(event)];
+}
+
+void EventDispatcher::reset_event_stats() {
+	event_statistics.fill({ 0, 0, 0 });
+}
+
+void EventDispatcher::measure(const Event event, void (EventDispatcher::*handler)()) {
+	const halrtcnt_t start = halGetCounterValue();
+	(this->*handler)();
+	const uint32_t us = uint64_t(halGetCounterValue() - start) * 1000000U / halGetCounterFrequency();
+
+	auto& stats = event_statistics[toUType(event)];
+	stats.count++;
+	stats.total_us += us;
+	if( us > stats.max_us ) {
+		stats.max_us = us;
+	}
+}
+
 eventmask_t EventDispatcher::wait() {
 	return chEvtWaitAny(ALL_EVENTS);
 }
@@ -175,19 +205,19 @@ void EventDispatcher::dispatch(const eventmask_t events) {
 	}
 
 	if( events & EVT_MASK_APPLICATION ) {
-		handle_application_queue();
+		measure(Event::Application, &EventDispatcher::handle_application_queue);
 	}
 
 	if( events & EVT_MASK_LOCAL ) {
-		handle_local_queue();
+		measure(Event::Local, &EventDispatcher::handle_local_queue);
 	}
 
 	if( events & EVT_MASK_RTC_TICK ) {
-		handle_rtc_tick();
+		measure(Event::RTCTick, &EventDispatcher::handle_rtc_tick);
 	}
 	
 	if( events & EVT_MASK_SWITCHES ) {
-		handle_switches();
+		measure(Event::Switches, &EventDispatcher::handle_switches);
 	}
 	
 	/*if( events & EVT_MASK_LCD_FRAME_SYNC ) {
@@ -196,15 +226,15 @@ void EventDispatcher::dispatch(const eventmask_t events) {
 
 	if( !EventDispatcher::display_sleep ) {
 		if( events & EVT_MASK_LCD_FRAME_SYNC ) {
-			handle_lcd_frame_sync();
+			measure(Event::FrameSync, &EventDispatcher::handle_lcd_frame_sync);
 		}
 
 		if( events & EVT_MASK_ENCODER ) {
-			handle_encoder();
+			measure(Event::Encoder, &EventDispatcher::handle_encoder);
 		}
 
 		if( events & EVT_MASK_TOUCH ) {
-			handle_touch();
+			measure(Event::Touch, &EventDispatcher::handle_touch);
 		}
 	}
 }
@@ -48,6 +48,24 @@ constexpr auto EVT_MASK_LOCAL           = EVENT_MASK(7);
 
 class EventDispatcher {
 public:
+	enum class Event : uint8_t {
+		Application = 0,
+		Local,
+		RTCTick,
+		Switches,
+		FrameSync,
+		Encoder,
+		Touch,
+	};
+	static constexpr size_t event_count = 7;
+
+	// Time spent in the handler for one event type since the last reset
+	struct EventStats {
+		uint32_t count;
+		uint32_t total_us;
+		uint32_t max_us;
+	};
+
 	EventDispatcher(
 		ui::Widget* const top_widget,
 		ui::Context& context
@@ -63,6 +81,9 @@ public:
 
 	static void set_display_sleep(const bool sleep);
 
+	static EventStats event_stats(const Event event);
+	static void reset_event_stats();
+
 	static inline void check_fifo_isr() {
 		if( !shared_memory.application_queue.is_empty() ) {
 			events_flag_isr(EVT_MASK_APPLICATION);
@@ -103,6 +124,7 @@ private:
 
 	eventmask_t wait();
 	void dispatch(const eventmask_t events);
+	void measure(const Event event, void (EventDispatcher::*handler)());
 
 	void handle_application_queue();
 	void handle_local_queue();
@@ -101,8 +101,8 @@ File::Size File::size() {
 	return { static_cast<File::Size>(f_size(&f)) };
 }
 
-Optional<File::Error> File::write_line(const std::string& s) {
-	const auto result_s = write(s.c_str(), s.size());
+Optional<File::Error> File::write_line(const std::string_view s) {
+	const auto result_s = write(s.data(), s.size());
 	if( result_s.is_error() ) {
 		return { result_s.error() };
 	}
@@ -30,6 +30,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <array>
 #include <memory>
 #include <iterator>
@@ -338,7 +339,7 @@ public:
 		return write(data.data(), N);
 	}
 
-	Optional<Error> write_line(const std::string& s);
+	Optional<Error> write_line(const std::string_view s);
 
 	// TODO: Return Result<>.
 	Optional<Error> sync();
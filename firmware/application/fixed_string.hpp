@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __FIXED_STRING_H__
+#define __FIXED_STRING_H__
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+/* Append-only string over caller-provided storage, so formatting on hot
+ * paths doesn't touch the heap. Anything appended past capacity is dropped
+ * and the contents always stay NUL-terminated.
+ */
+class StringBuffer {
+public:
+	StringBuffer(const StringBuffer&) = delete;
+	StringBuffer& operator=(const StringBuffer&) = delete;
+
+	const char* c_str() const {
+		return data_;
+	}
+
+	size_t size() const {
+		return length_;
+	}
+
+	size_t capacity() const {
+		return capacity_;
+	}
+
+	bool empty() const {
+		return length_ == 0;
+	}
+
+	void clear() {
+		length_ = 0;
+		data_[0] = 0;
+	}
+
+	operator std::string_view() const {
+		return { data_, length_ };
+	}
+
+	std::string str() const {
+		return { data_, length_ };
+	}
+
+	StringBuffer& operator+=(const char c) {
+		if( length_ < capacity_ ) {
+			data_[length_++] = c;
+			data_[length_] = 0;
+		}
+		return *this;
+	}
+
+	StringBuffer& operator+=(const std::string_view s) {
+		const size_t n = std::min(s.size(), capacity_ - length_);
+		memcpy(&data_[length_], s.data(), n);
+		length_ += n;
+		data_[length_] = 0;
+		return *this;
+	}
+
+	void append(const size_t count, const char c) {
+		const size_t n = std::min(count, capacity_ - length_);
+		memset(&data_[length_], c, n);
+		length_ += n;
+		data_[length_] = 0;
+	}
+
+	// Truncates, or pads with c up to the given length
+	void resize(const size_t length, const char c = ' ') {
+		if( length < length_ ) {
+			length_ = length;
+			data_[length_] = 0;
+		} else {
+			append(length - length_, c);
+		}
+	}
+
+protected:
+	constexpr StringBuffer(
+		char* const data,
+		const size_t capacity
+	) : data_ { data },
+		capacity_ { capacity }
+	{
+	}
+
+private:
+	char* const data_;
+	const size_t capacity_;
+	size_t length_ { 0 };
+};
+
+template<size_t N>
+class FixedString : public StringBuffer {
+public:
+	FixedString(
+	) : StringBuffer { storage, N }
+	{
+	}
+
+	FixedString(
+		const std::string_view s
+	) : FixedString { }
+	{
+		*this += s;
+	}
+
+	FixedString(
+		const FixedString& other
+	) : FixedString { std::string_view { other } }
+	{
+	}
+
+	FixedString& operator=(const FixedString& other) {
+		if( this != &other ) {
+			clear();
+			*this += std::string_view { other };
+		}
+		return *this;
+	}
+
+private:
+	char storage[N + 1] { 0 };
+};
+
+#endif/*__FIXED_STRING_H__*/
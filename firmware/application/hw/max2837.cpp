@@ -207,41 +207,83 @@ void MAX2837::set_lpf_rf_bandwidth(const uint32_t bandwidth_minimum) {
 }
 
 bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
-	/* TODO: This is a sad implementation. Refactor. */
-	if( lo::band[0].contains(lo_frequency) ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b00;	/* 2300 - 2399.99MHz */
-		_map.r.rxrf_1.LNAband = 0;				/* 2.3 - 2.5GHz */
-	} else if( lo::band[1].contains(lo_frequency)  ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b01;	/* 2400 - 2499.99MHz */
-		_map.r.rxrf_1.LNAband = 0;				/* 2.3 - 2.5GHz */
-	} else if( lo::band[2].contains(lo_frequency) ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b10;	/* 2500 - 2599.99MHz */
-		_map.r.rxrf_1.LNAband = 1;				/* 2.5 - 2.7GHz */
-	} else if( lo::band[3].contains(lo_frequency) ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b11;	/* 2600 - 2700Hz */
-		_map.r.rxrf_1.LNAband = 1;				/* 2.5 - 2.7GHz */
-	} else {
+	const auto synth = synth_registers(lo_frequency);
+	if( !synth.is_valid() ) {
 		return false;
 	}
+
 	_dirty[Register::SYN_INT_DIV] = 1;
 	_dirty[Register::RXRF_1] = 1;
+	_dirty[Register::SYN_FR_DIV_2] = 1;
+	_dirty[Register::SYN_FR_DIV_1] = 1;
+	return set_synth_registers(synth);
+}
+
+SynthRegisters MAX2837::synth_registers(const rf::Frequency lo_frequency) const {
+	RegisterMap map { _map };
+
+	/* LOGEN_BSW: 2300, 2400, 2500 or 2600MHz band */
+	size_t band_index = 0;
+	while( (band_index < lo::band.size()) && !lo::band[band_index].contains(lo_frequency) ) {
+		band_index++;
+	}
+	if( band_index >= lo::band.size() ) {
+		return { 0, 0, 0 };
+	}
+	map.r.syn_int_div.LOGEN_BSW = band_index;
 
 	const uint64_t div_q20 = (lo_frequency * (1 << 20)) / pll_factor;
 
-	_map.r.syn_int_div.SYN_INTDIV = div_q20 >> 20;
-	_dirty[Register::SYN_INT_DIV] = 1;
-	_map.r.syn_fr_div_2.SYN_FRDIV_19_10 = (div_q20 >> 10) & 0x3ff;
-	_dirty[Register::SYN_FR_DIV_2] = 1;
+	map.r.syn_int_div.SYN_INTDIV = div_q20 >> 20;
+	map.r.syn_fr_div_2.SYN_FRDIV_19_10 = (div_q20 >> 10) & 0x3ff;
+	map.r.syn_fr_div_1.SYN_FRDIV_9_0 = (div_q20 & 0x3ff);
+
+	return {
+		map.w[toUType(Register::SYN_INT_DIV)],
+		map.w[toUType(Register::SYN_FR_DIV_2)],
+		map.w[toUType(Register::SYN_FR_DIV_1)],
+	};
+}
+
+bool MAX2837::set_synth_registers(const SynthRegisters& synth) {
+	if( !synth.is_valid() ) {
+		return false;
+	}
+
+	/* Low FRDIV commits the change, so hold it back until the rest is out */
+	bool commit = _dirty[Register::SYN_FR_DIV_1];
+	commit |= stage(Register::SYN_FR_DIV_1, synth.syn_fr_div_1);
+	_dirty[Register::SYN_FR_DIV_1] = 0;
+	commit |= stage(Register::SYN_INT_DIV, synth.syn_int_div);
+	commit |= stage(Register::SYN_FR_DIV_2, synth.syn_fr_div_2);
+
+	/* 2.3 - 2.5GHz or 2.5 - 2.7GHz */
+	const reg_t lna_band = (_map.r.syn_int_div.LOGEN_BSW >= 0b10) ? 1 : 0;
+	if( _map.r.rxrf_1.LNAband != lna_band ) {
+		_map.r.rxrf_1.LNAband = lna_band;
+		_dirty[Register::RXRF_1] = 1;
+	}
+
 	/* flush to commit high FRDIV first, as low FRDIV commits the change */
 	flush();
 
-	_map.r.syn_fr_div_1.SYN_FRDIV_9_0 = (div_q20 & 0x3ff);
-	_dirty[Register::SYN_FR_DIV_1] = 1;
-	flush();
+	if( commit ) {
+		flush_one(Register::SYN_FR_DIV_1);
+	}
 
 	return true;
 }
 
+bool MAX2837::stage(const Register reg, const reg_t value) {
+	const auto reg_num = toUType(reg);
+	if( _map.w[reg_num] == value ) {
+		return false;
+	}
+	_map.w[reg_num] = value;
+	_dirty[reg_num] = 1;
+	return true;
+}
+
 void MAX2837::set_rx_lo_iq_calibration(const size_t v) {
 	_map.r.rx_top_rx_bias.RX_IQERR_SPI_EN = 1;
 	_dirty[Register::RX_TOP_RX_BIAS] = 1;
@@ -826,6 +826,19 @@ constexpr RegisterMap initial_register_values { Register_Type {
 	},
 } };
 
+/* Synthesizer divider registers for one LO frequency. Computed ahead of time
+ * so hopping through a known set of frequencies skips the 64-bit divide.
+ */
+struct SynthRegisters {
+	reg_t syn_int_div;
+	reg_t syn_fr_div_2;
+	reg_t syn_fr_div_1;
+
+	bool is_valid() const {
+		return syn_int_div != 0;
+	}
+};
+
 class MAX2837 {
 public:
 	constexpr MAX2837(
@@ -884,6 +897,9 @@ public:
 
 	bool set_frequency(const rf::Frequency lo_frequency);
 
+	SynthRegisters synth_registers(const rf::Frequency lo_frequency) const;
+	bool set_synth_registers(const SynthRegisters& synth);
+
 	void set_rx_lo_iq_calibration(const size_t v);
 	void set_rx_bias_trim(const size_t v);
 	void set_vco_bias(const size_t v);
@@ -900,6 +916,7 @@ private:
 	DirtyRegisters<Register, reg_count> _dirty { };
 
 	void flush_one(const Register reg);
+	bool stage(const Register reg, const reg_t value);
 
 	void write(const address_t reg_num, const reg_t value);
 
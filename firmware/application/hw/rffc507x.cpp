@@ -216,6 +216,10 @@ void RFFC507x::disable() {
 	flush_one(Register::SDI_CTRL);
 }
 
+bool RFFC507x::is_enabled() const {
+	return _map.r.sdi_ctrl.enbl;
+}
+
 void RFFC507x::set_mixer_current(const uint8_t value) {
 	/* MIX IDD = 0b000 appears to turn the mixer completely off */
 	/* TODO: Adjust mixer current. Graphs in datasheet suggest:
@@ -233,26 +237,69 @@ void RFFC507x::set_mixer_current(const uint8_t value) {
 }
 
 void RFFC507x::set_frequency(const rf::Frequency lo_frequency) {
+	_dirty[Register::LF] = 1;
+	_dirty[Register::P2_FREQ1] = 1;
+	_dirty[Register::P2_FREQ2] = 1;
+	_dirty[Register::P2_FREQ3] = 1;
+	update_synth(synth_registers(lo_frequency));
+}
+
+SynthRegisters RFFC507x::synth_registers(const rf::Frequency lo_frequency) const {
 	const SynthConfig synth_config = SynthConfig::calculate(lo_frequency);
 
+	RegisterMap map { _map };
+	map.r.p2_freq1.p2n = synth_config.n_divider_q24 >> 24;
+	map.r.p2_freq1.p2lodiv = synth_config.lo_divider_log2;
+	map.r.p2_freq1.p2presc = synth_config.prescaler_divider_log2;
+	map.r.p2_freq2.p2nmsb = (synth_config.n_divider_q24 >> 8) & 0xffff;
+	map.r.p2_freq3.p2nlsb = synth_config.n_divider_q24 & 0xff;
+
+	return {
+		map.w[toUType(Register::P2_FREQ1)],
+		map.w[toUType(Register::P2_FREQ2)],
+		map.w[toUType(Register::P2_FREQ3)],
+	};
+}
+
+void RFFC507x::set_synth_registers(const SynthRegisters& synth) {
+	/* Already running at these dividers, skip the disable/calibrate cycle */
+	if( is_enabled()
+	 && (_map.w[toUType(Register::P2_FREQ1)] == synth.p2_freq1)
+	 && (_map.w[toUType(Register::P2_FREQ2)] == synth.p2_freq2)
+	 && (_map.w[toUType(Register::P2_FREQ3)] == synth.p2_freq3) ) {
+		return;
+	}
+
+	disable();
+	update_synth(synth);
+	enable();
+}
+
+bool RFFC507x::stage(const Register reg, const reg_t value) {
+	const auto reg_num = toUType(reg);
+	if( _map.w[reg_num] == value ) {
+		return false;
+	}
+	_map.w[reg_num] = value;
+	_dirty[reg_num] = 1;
+	return true;
+}
+
+void RFFC507x::update_synth(const SynthRegisters& synth) {
+	stage(Register::P2_FREQ1, synth.p2_freq1);
+	stage(Register::P2_FREQ2, synth.p2_freq2);
+	stage(Register::P2_FREQ3, synth.p2_freq3);
+
 	/* Boost charge pump leakage if VCO frequency > 3.2GHz, indicated by
 	 * prescaler divider set to 4 (log2=2) instead of 2 (log2=1).
 	 */
-	if( synth_config.prescaler_divider_log2 == 2 ) {
-		_map.r.lf.pllcpl = 3;
-	} else {
-		_map.r.lf.pllcpl = 2;
+	const reg_t pllcpl = (_map.r.p2_freq1.p2presc == 2) ? 3 : 2;
+	if( _map.r.lf.pllcpl != pllcpl ) {
+		_map.r.lf.pllcpl = pllcpl;
+		_dirty[Register::LF] = 1;
 	}
-	flush_one(Register::LF);
 
-	_map.r.p2_freq1.p2n = synth_config.n_divider_q24 >> 24;
-	_map.r.p2_freq1.p2lodiv = synth_config.lo_divider_log2;
-	_map.r.p2_freq1.p2presc = synth_config.prescaler_divider_log2;
-	_map.r.p2_freq2.p2nmsb = (synth_config.n_divider_q24 >> 8) & 0xffff;
-	_map.r.p2_freq3.p2nlsb = synth_config.n_divider_q24 & 0xff;
-	_dirty[Register::P2_FREQ1] = 1;
-	_dirty[Register::P2_FREQ2] = 1;
-	_dirty[Register::P2_FREQ3] = 1;
+	/* LF is register 0, so it still goes out ahead of the dividers */
 	flush();
 }
 
@@ -796,6 +796,15 @@ constexpr RegisterMap default_hackrf_one { Register_Type {
 	},
 } };
 
+/* Synthesizer divider registers for one LO frequency. Computed ahead of time
+ * so hopping through a known set of frequencies skips the divider math.
+ */
+struct SynthRegisters {
+	reg_t p2_freq1;
+	reg_t p2_freq2;
+	reg_t p2_freq3;
+};
+
 class RFFC507x {
 public:
 	void init();
@@ -805,9 +814,13 @@ public:
 
 	void enable();
 	void disable();
+	bool is_enabled() const;
 
 	void set_mixer_current(const uint8_t value);
 	void set_frequency(const rf::Frequency lo_frequency);
+
+	SynthRegisters synth_registers(const rf::Frequency lo_frequency) const;
+	void set_synth_registers(const SynthRegisters& synth);
 	void set_gpo1(const bool new_value);
 	
 	reg_t read(const address_t reg_num);
@@ -824,6 +837,8 @@ private:
 	reg_t read(const Register reg);
 
 	void flush_one(const Register reg);
+	bool stage(const Register reg, const reg_t value);
+	void update_synth(const SynthRegisters& synth);
 
 	reg_t readback(const Readback readback);
 
@@ -22,6 +22,8 @@
 
 #include "io_wave.hpp"
 
+#include <algorithm>
+
 bool WAVFileReader::open(const std::filesystem::path& path) {
 	size_t i = 0;
 	char ch;
@@ -180,6 +182,10 @@ uint32_t WAVFileReader::data_size() {
 	return data_size_;
 }
 
+uint32_t WAVFileReader::data_offset() {
+	return data_start;
+}
+
 uint32_t WAVFileReader::sample_count() {
 	return data_size_ / bytes_per_sample;
 }
@@ -188,6 +194,95 @@ uint16_t WAVFileReader::bits_per_sample() {
 	return header.fmt.wBitsPerSample;
 }
 
+WAVStreamReader::WAVStreamReader(
+	std::unique_ptr<WAVFileReader> wav_reader
+) : wav { std::move(wav_reader) },
+	chunk { std::make_unique<uint8_t[]>(frame_max + chunk_size) }
+{
+	wav->rewind();
+	file_offset = wav->data_offset();
+	remaining = wav->data_size();
+	bits_per_sample = wav->bits_per_sample();
+	channels = wav->channels();
+	frame_size = channels * (bits_per_sample / 8);
+}
+
+File::Result<File::Size> WAVStreamReader::read(void* const buffer, const File::Size bytes) {
+	int16_t* out = static_cast<int16_t*>(buffer);
+	const size_t samples = bytes / sizeof(int16_t);
+	size_t done = 0;
+
+	while (done < samples) {
+		const size_t available = (chunk_fill - chunk_pos) / frame_size;
+		if (!available) {
+			const auto fill_result = fill_chunk();
+			if (fill_result.is_error())
+				return fill_result.error();
+			if (!fill_result.value())
+				break;		// End of data
+			continue;
+		}
+
+		done += convert(&out[done], std::min(available, samples - done));
+	}
+
+	return done * sizeof(int16_t);
+}
+
+File::Result<File::Size> WAVStreamReader::fill_chunk() {
+	// A frame split across two reads is moved just before the 4-aligned read destination
+	const size_t leftover = chunk_fill - chunk_pos;
+	memmove(&chunk[frame_max - leftover], &chunk[chunk_pos], leftover);
+	chunk_pos = frame_max - leftover;
+	chunk_fill = frame_max;
+
+	uint32_t to_read = chunk_size;
+	const uint32_t read_end = (file_offset + to_read) & ~(sector_size - 1);
+	if (read_end > file_offset)
+		to_read = read_end - file_offset;
+	to_read = std::min(to_read, remaining);
+	if (!to_read)
+		return static_cast<File::Size>(0);
+
+	const auto read_result = wav->read(&chunk[frame_max], to_read);
+	if (read_result.is_error())
+		return read_result.error();
+
+	const auto got = read_result.value();
+	chunk_fill += got;
+	file_offset += got;
+	remaining = got ? remaining - got : 0;	// Data chunk longer than the file
+	return got;
+}
+
+size_t WAVStreamReader::convert(int16_t* out, const size_t frames) {
+	const uint8_t* p = &chunk[chunk_pos];
+
+	if (bits_per_sample == 16) {
+		if (channels == 1) {
+			memcpy(out, p, frames * sizeof(int16_t));
+		} else {
+			// Byte accesses, the M0 can't do unaligned halfwords
+			for (size_t i = 0; i < frames; i++, p += 4) {
+				const int16_t left = p[0] | (p[1] << 8);
+				const int16_t right = p[2] | (p[3] << 8);
+				out[i] = ((int32_t)left + right) / 2;
+			}
+		}
+	} else {
+		if (channels == 1) {
+			for (size_t i = 0; i < frames; i++)
+				out[i] = (p[i] - 0x80) * 256;
+		} else {
+			for (size_t i = 0; i < frames; i++, p += 2)
+				out[i] = (p[0] + p[1] - 0x100) * 128;
+		}
+	}
+
+	chunk_pos += frames * frame_size;
+	return frames;
+}
+
 Optional<File::Error> WAVFileWriter::create(
 	const std::filesystem::path& filename,
 	size_t sampling_rate_set,
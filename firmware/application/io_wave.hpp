@@ -28,6 +28,7 @@
 #include "optional.hpp"
 
 #include <string.h>
+#include <memory>
 
 struct fmt_pcm_t {
 	constexpr fmt_pcm_t(
@@ -119,6 +120,7 @@ public:
 	uint16_t channels();
 	uint32_t sample_rate();
 	uint32_t data_size();
+	uint32_t data_offset();
 	uint32_t sample_count();
 	uint16_t bits_per_sample();
 	std::string title();
@@ -160,6 +162,43 @@ private:
 	bool check_header();
 };
 
+/* Streams the data chunk of a WAV file as signed 16-bit mono samples, whatever
+ * its format (8 or 16-bit, mono or stereo), so that the baseband can use them
+ * as is. The file is read in large chunks ending on sector boundaries, which
+ * FatFs transfers straight from the card instead of through its sector buffer.
+ * Trailing chunks (LIST...) aren't sent.
+ */
+class WAVStreamReader : public stream::Reader {
+public:
+	WAVStreamReader(std::unique_ptr<WAVFileReader> wav_reader);
+
+	WAVStreamReader(const WAVStreamReader&) = delete;
+	WAVStreamReader& operator=(const WAVStreamReader&) = delete;
+	WAVStreamReader(WAVStreamReader&&) = delete;
+	WAVStreamReader& operator=(WAVStreamReader&&) = delete;
+
+	// Bytes is rounded down to whole samples
+	File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+
+private:
+	static constexpr size_t chunk_size = 4096;
+	static constexpr size_t sector_size = 512;
+	static constexpr size_t frame_max = 4;	// 16-bit stereo
+
+	std::unique_ptr<WAVFileReader> wav;
+	std::unique_ptr<uint8_t[]> chunk;
+	size_t chunk_pos { 0 };
+	size_t chunk_fill { 0 };
+	uint32_t file_offset { 0 };
+	uint32_t remaining { 0 };
+	uint16_t bits_per_sample { 16 };
+	uint16_t channels { 1 };
+	size_t frame_size { 2 };
+
+	File::Result<File::Size> fill_chunk();
+	size_t convert(int16_t* out, const size_t frames);
+};
+
 class WAVFileWriter : public FileWriter {
 public:
 	WAVFileWriter() = default;
@@ -23,12 +23,19 @@
 
 #include "string_format.hpp"
 
-Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string& entry) {
-	std::string timestamp = to_string_timestamp(datetime);
-	return write_line(timestamp + " " + entry);
+Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string_view entry) {
+	FixedString<15> timestamp;
+	format_into(timestamp, fmt::timestamp(datetime), ' ');
+
+	// Written in two parts so the entry is never copied
+	const auto result = file.write(timestamp.c_str(), timestamp.size());
+	if( result.is_error() ) {
+		return { result.error() };
+	}
+	return write_line(entry);
 }
 
-Optional<File::Error> LogFile::write_line(const std::string& message) {
+Optional<File::Error> LogFile::write_line(const std::string_view message) {
 	auto error = file.write_line(message);
 	if( !error.is_valid() ) {
 		file.sync();
@@ -23,6 +23,7 @@
 #define __LOG_FILE_H__
 
 #include <string>
+#include <string_view>
 
 #include "file.hpp"
 
@@ -35,12 +36,12 @@ public:
 		return file.append(filename);
 	}
 
-	Optional<File::Error> write_entry(const rtc::RTC& datetime, const std::string& entry);
+	Optional<File::Error> write_entry(const rtc::RTC& datetime, const std::string_view entry);
 
 private:
 	File file { };
 
-	Optional<File::Error> write_line(const std::string& message);
+	Optional<File::Error> write_line(const std::string_view message);
 };
 
 #endif/*__LOG_FILE_H__*/
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace lz4 {
+
+/* Decodes one raw LZ4 block (no frame header or checksums), as written by
+ * tools/make_spi_image.py. Returns the number of bytes written to dst, or 0
+ * if the block is malformed or doesn't fit in dst_capacity.
+ */
+size_t decompress_block(
+	const uint8_t* src,
+	const size_t src_length,
+	uint8_t* const dst,
+	const size_t dst_capacity
+);
+
+} /* namespace lz4 */
+
+#endif/*__LZ4_H__*/
@@ -0,0 +1,71 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "packet_dedup.hpp"
+
+#include "crc.hpp"
+
+using crc32_t = CRC<32, true, true>;
+
+static constexpr crc32_t crc32_ieee { 0x04c11db7, 0xffffffff, 0xffffffff };
+
+bool PacketDedup::is_repeat(const uint32_t key) {
+	if( !window ) {
+		return false;
+	}
+
+	const auto now = chTimeNow();
+	const size_t start = key % slot_count;
+	Slot* victim = nullptr;
+	systime_t victim_rank = 0;
+
+	for(size_t i=0; i<probe_count; i++) {
+		auto& slot = slots[(start + i) % slot_count];
+		const systime_t age = now - slot.time;
+		const bool live = slot.used && (age < window);
+
+		if( live && (slot.key == key) ) {
+			return true;
+		}
+
+		// Free and expired slots go first, then the oldest live one
+		const systime_t rank = live ? age : window;
+		if( !victim || (rank > victim_rank) ) {
+			victim = &slot;
+			victim_rank = rank;
+		}
+	}
+
+	*victim = { key, now, true };
+	return false;
+}
+
+uint32_t PacketDedup::key(const baseband::Packet& packet) {
+	auto crc = crc32_ieee;
+	for(size_t i=0; i<packet.size(); i++) {
+		crc.process_bit(packet[i]);
+	}
+	return crc.checksum() ^ packet.size();
+}
+
+uint32_t PacketDedup::key(const uint8_t* const data, const size_t length) {
+	auto crc = crc32_ieee;
+	crc.process_bytes(data, length);
+	return crc.checksum();
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PACKET_DEDUP_H__
+#define __PACKET_DEDUP_H__
+
+#include "ch.h"
+
+#include "baseband_packet.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* Remembers payloads seen in the last window_ms, by CRC-32, so that repeats
+ * of the same transmission can be dropped before any formatting or logging.
+ * A repeat doesn't refresh its slot: a beacon that keeps sending the same
+ * payload comes through again once per window. A window of 0 lets everything
+ * through.
+ */
+class PacketDedup {
+public:
+	constexpr PacketDedup(
+		const uint32_t window_ms
+	) : window { window_ms ? MS2ST(window_ms) : 0 }
+	{
+	}
+
+	// True if seen within the window, otherwise remembered for next time
+	bool is_repeat(const uint32_t key);
+
+	bool is_repeat(const baseband::Packet& packet) {
+		return is_repeat(key(packet));
+	}
+
+	bool is_repeat(const uint8_t* const data, const size_t length) {
+		return is_repeat(key(data, length));
+	}
+
+	static uint32_t key(const baseband::Packet& packet);
+	static uint32_t key(const uint8_t* const data, const size_t length);
+
+private:
+	static constexpr size_t slot_count = 32;
+	static constexpr size_t probe_count = 4;
+
+	struct Slot {
+		uint32_t key;
+		systime_t time;
+		bool used;
+	};
+
+	const systime_t window;
+	std::array<Slot, slot_count> slots { };
+};
+
+#endif/*__PACKET_DEDUP_H__*/
@@ -23,7 +23,7 @@
 #include "bht.hpp"
 #include "portapack_persistent_memory.hpp"
 
-size_t gen_message_ep(uint8_t city_code, size_t family_code_ep, uint32_t relay_number, uint32_t relay_state) {
+std::string gen_message_ep(uint8_t city_code, size_t family_code_ep, uint32_t relay_number, uint32_t relay_state) {
 	size_t c;
 	const encoder_def_t * um3750_def;
 	uint8_t bits[12];
@@ -56,8 +56,8 @@ size_t gen_message_ep(uint8_t city_code, size_t family_code_ep, uint32_t relay_n
 			ep_fragments += um3750_def->bit_format[bits[c++]];
 	}
 	
-	// Return bitstream length
-	return make_bitstream(ep_fragments);
+	// Packed by the caller's FragmentsReader as it's transmitted
+	return ep_fragments;
 }
 
 std::string gen_message_xy(const std::string& ascii_code) {
@@ -83,5 +83,36 @@ void bitstream_append(size_t& bitstream_length, uint32_t bit_count, uint32_t bit
 	
 	bitstream[bitstream_length >> 3] = byte;
 }
+
+FragmentsReader::FragmentsReader(
+	std::string fragments,
+	const uint32_t repeat
+) : fragments { std::move(fragments) },
+	bits_left { this->fragments.size() * repeat }
+{
+}
+
+File::Result<File::Size> FragmentsReader::read(void* const buffer, const File::Size bytes) {
+	uint8_t * p = static_cast<uint8_t*>(buffer);
+	
+	for (File::Size n = 0; n < bytes; n++) {
+		uint8_t byte = 0;
+		
+		for (size_t b = 0; b < 8; b++) {
+			byte <<= 1;
+			if (bits_left) {
+				if (fragments[index] != '0')
+					byte |= 1;
+				if (++index == fragments.size())
+					index = 0;
+				bits_left--;
+			}
+		}
+		
+		p[n] = byte;
+	}
+	
+	return bytes;
+}
 	
 } /* namespace encoders */
@@ -24,6 +24,8 @@
 #include <cstring>
 #include <string>
 
+#include "io.hpp"
+
 #ifndef __ENCODERS_H__
 #define __ENCODERS_H__
 
@@ -36,6 +38,21 @@ namespace encoders {
 	
 	size_t make_bitstream(std::string& fragments);
 	void bitstream_append(size_t& bitstream_length, uint32_t bit_count, uint32_t bits);
+	
+	// Same packing as make_bitstream(), streamed to the OOK baseband through
+	// a ReplayThread so the frame isn't limited by the size of bb_data.
+	// Repeats follow each other back to back, then zeros until the thread stops.
+	class FragmentsReader : public stream::Reader {
+	public:
+		FragmentsReader(std::string fragments, const uint32_t repeat);
+		
+		File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+		
+	private:
+		const std::string fragments;
+		size_t bits_left;
+		size_t index { 0 };
+	};
 
 	struct encoder_def_t {
 		char name[16];							// Encoder chip ref/name
@@ -96,6 +96,17 @@ static baseband::CPLD baseband_cpld;
 
 static rf::Direction direction { rf::Direction::Receive };
 
+static debug::RetuneStats retune_statistics { 0, 0, 0 };
+
+static void record_retune(const halrtcnt_t start) {
+	const uint32_t us = uint64_t(halGetCounterValue() - start) * 1000000U / halGetCounterFrequency();
+	retune_statistics.count++;
+	retune_statistics.last_us = us;
+	if( us > retune_statistics.max_us ) {
+		retune_statistics.max_us = us;
+	}
+}
+
 void init() {
 	rf_path.init();
 	first_if.init();
@@ -136,6 +147,7 @@ void set_direction(const rf::Direction new_direction) {
 }
 
 bool set_tuning_frequency(const rf::Frequency frequency) {
+	const halrtcnt_t start = halGetCounterValue();
 	const auto tuning_config = tuning::config::create(frequency);
 	if( tuning_config.is_valid() ) {
 		first_if.disable();
@@ -150,12 +162,52 @@ bool set_tuning_frequency(const rf::Frequency frequency) {
 		rf_path.set_band(tuning_config.rf_path_band);
 		baseband_cpld.set_invert(tuning_config.baseband_invert);
 
+		record_retune(start);
 		return result_second_if;
 	} else {
 		return false;
 	}
 }
 
+TuningPlan tuning_plan(const rf::Frequency frequency) {
+	TuningPlan plan { };
+
+	const auto tuning_config = tuning::config::create(frequency);
+	if( tuning_config.is_valid() ) {
+		plan.first_if_enabled = (tuning_config.first_lo_frequency != 0);
+		if( plan.first_if_enabled ) {
+			plan.first_if = first_if.synth_registers(tuning_config.first_lo_frequency);
+		}
+		plan.second_if = second_if.synth_registers(tuning_config.second_lo_frequency);
+		plan.rf_path_band = tuning_config.rf_path_band;
+		plan.baseband_invert = tuning_config.baseband_invert;
+	}
+
+	return plan;
+}
+
+bool set_tuning_plan(const TuningPlan& plan) {
+	if( !plan.is_valid() ) {
+		return false;
+	}
+
+	const halrtcnt_t start = halGetCounterValue();
+
+	if( plan.first_if_enabled ) {
+		first_if.set_synth_registers(plan.first_if);
+	} else if( first_if.is_enabled() ) {
+		first_if.disable();
+	}
+
+	const auto result_second_if = second_if.set_synth_registers(plan.second_if);
+
+	rf_path.set_band(plan.rf_path_band);
+	baseband_cpld.set_invert(plan.baseband_invert);
+
+	record_retune(start);
+	return result_second_if;
+}
+
 void set_rf_amp(const bool rf_amp) {
 	rf_path.set_rf_amp(rf_amp);
 	/*
@@ -220,6 +272,14 @@ void configure(Configuration configuration) {
 
 namespace debug {
 
+RetuneStats retune_stats() {
+	return retune_statistics;
+}
+
+void reset_retune_stats() {
+	retune_statistics = { 0, 0, 0 };
+}
+
 namespace first_if {
 
 uint32_t register_read(const size_t register_number) {
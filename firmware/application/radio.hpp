@@ -23,6 +23,8 @@
 #define __RADIO_H__
 
 #include "rf_path.hpp"
+#include "rffc507x.hpp"
+#include "max2837.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -39,10 +41,28 @@ struct Configuration {
 	int8_t vga_gain;
 };
 
+/* Everything set_tuning_frequency() works out for one frequency, so a list
+ * of frequencies can be prepared once and hopped through with
+ * set_tuning_plan(), which only writes the registers that change.
+ */
+struct TuningPlan {
+	rffc507x::SynthRegisters first_if;
+	max2837::SynthRegisters second_if;
+	rf::path::Band rf_path_band;
+	bool first_if_enabled;
+	bool baseband_invert;
+
+	bool is_valid() const {
+		return second_if.is_valid();
+	}
+};
+
 void init();
 
 void set_direction(const rf::Direction new_direction);
 bool set_tuning_frequency(const rf::Frequency frequency);
+TuningPlan tuning_plan(const rf::Frequency frequency);
+bool set_tuning_plan(const TuningPlan& plan);
 void set_rf_amp(const bool rf_amp);
 void set_lna_gain(const int_fast8_t db);
 void set_vga_gain(const int_fast8_t db);
@@ -57,6 +77,15 @@ void disable();
 
 namespace debug {
 
+struct RetuneStats {
+	uint32_t count;
+	uint32_t last_us;
+	uint32_t max_us;
+};
+
+RetuneStats retune_stats();
+void reset_retune_stats();
+
 namespace first_if {
 
 uint32_t register_read(const size_t register_number);
@@ -67,6 +67,15 @@ void ReceiverModel::set_tuning_frequency(rf::Frequency f) {
 	update_tuning_frequency();
 }
 
+radio::TuningPlan ReceiverModel::tuning_plan(rf::Frequency f) {
+	return radio::tuning_plan(f + tuning_offset());
+}
+
+void ReceiverModel::set_tuning_frequency(rf::Frequency f, const radio::TuningPlan& plan) {
+	persistent_memory::set_tuned_frequency(f);
+	radio::set_tuning_plan(plan);
+}
+
 rf::Frequency ReceiverModel::frequency_step() const {
 	return frequency_step_;
 }
@@ -28,6 +28,7 @@
 #include "message.hpp"
 #include "rf_path.hpp"
 #include "max2837.hpp"
+#include "radio.hpp"
 #include "volume.hpp"
 
 class ReceiverModel {
@@ -43,6 +44,11 @@ public:
 	rf::Frequency tuning_frequency() const;
 	void set_tuning_frequency(rf::Frequency f);
 
+	/* Plans only stay valid while tuning_offset() doesn't change */
+	radio::TuningPlan tuning_plan(rf::Frequency f);
+	void set_tuning_frequency(rf::Frequency f, const radio::TuningPlan& plan);
+	int32_t tuning_offset();
+
 	rf::Frequency frequency_step() const;
 	void set_frequency_step(rf::Frequency f);
 
@@ -115,8 +121,6 @@ private:
 	volume_t headphone_volume_ { -43.0_dB };
 	uint8_t squelch_level_ { 80 };
 
-	int32_t tuning_offset();
-
 	void update_tuning_frequency();
 	void update_antenna_bias();
 	void update_rf_amp();
@@ -88,13 +88,10 @@ uint32_t ReplayThread::run() {
 		if (prefill_buffer == nullptr) {
 			buffers.put_app(prefill_buffer);
 		} else {
-			size_t blocks = config.read_size / 512;
-			
-			for (size_t c = 0; c < blocks; c++) {
-				auto read_result = reader->read(&((uint8_t*)prefill_buffer->data())[c * 512], 512);
-				if( read_result.is_error() ) {
-					return READ_ERROR;
-				}
+			// One read per buffer, readers do their own chunking
+			auto read_result = reader->read(prefill_buffer->data(), config.read_size);
+			if( read_result.is_error() ) {
+				return READ_ERROR;
 			}
 			
 			prefill_buffer->set_size(config.read_size);
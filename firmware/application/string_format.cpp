@@ -21,6 +21,8 @@
 
 #include "string_format.hpp"
 
+#include <cmath>
+
 static char* to_string_dec_uint_internal(
 	char* p,
 	uint32_t n
@@ -70,34 +72,34 @@ std::string to_string_bin(
 	return p;
 }
 
-std::string to_string_dec_uint(
-	const uint32_t n,
-	const int32_t l,
-	const char fill
-) {
+void format_into(StringBuffer& out, const std::string_view s) {
+	out += s;
+}
+
+void format_into(StringBuffer& out, const char c) {
+	out += c;
+}
+
+void format_into(StringBuffer& out, const fmt::DecUInt& field) {
 	char p[16];
 	auto term = p + sizeof(p) - 1;
-	auto q = to_string_dec_uint_pad_internal(term, n, l, fill);
+	auto q = to_string_dec_uint_pad_internal(term, field.n, field.l, field.fill);
 
 	// Right justify.
-	while( (term - q) < l ) {
+	while( (term - q) < field.l ) {
 		*(--q) = ' ';
 	}
 
-	return q;
+	out += std::string_view { q, static_cast<size_t>(term - q) };
 }
 
-std::string to_string_dec_int(
-	const int32_t n,
-	const int32_t l,
-	const char fill
-) {
-	const size_t negative = (n < 0) ? 1 : 0;
-	uint32_t n_abs = negative ? -n : n;
+void format_into(StringBuffer& out, const fmt::DecInt& field) {
+	const size_t negative = (field.n < 0) ? 1 : 0;
+	uint32_t n_abs = negative ? -field.n : field.n;
 
 	char p[16];
 	auto term = p + sizeof(p) - 1;
-	auto q = to_string_dec_uint_pad_internal(term, n_abs, l - negative, fill);
+	auto q = to_string_dec_uint_pad_internal(term, n_abs, field.l - negative, field.fill);
 
 	// Add sign.
 	if( negative ) {
@@ -105,16 +107,41 @@ std::string to_string_dec_int(
 	}
 
 	// Right justify.
-	while( (term - q) < l ) {
+	while( (term - q) < field.l ) {
 		*(--q) = ' ';
 	}
 
-	return q;
+	out += std::string_view { q, static_cast<size_t>(term - q) };
+}
+
+std::string to_string_dec_uint(
+	const uint32_t n,
+	const int32_t l,
+	const char fill
+) {
+	FixedString<15> s;
+	format_into(s, fmt::dec_uint(n, l, fill));
+	return s.str();
+}
+
+std::string to_string_dec_int(
+	const int32_t n,
+	const int32_t l,
+	const char fill
+) {
+	FixedString<15> s;
+	format_into(s, fmt::dec_int(n, l, fill));
+	return s.str();
+}
+
+void format_into(StringBuffer& out, const fmt::ShortFreq& field) {
+	format_into(out, fmt::dec_int(field.f / 1000000, 4), '.', fmt::dec_int((field.f / 100) % 10000, 4, '0'));
 }
 
 std::string to_string_short_freq(const uint64_t f) {
-	auto final_str = to_string_dec_int(f / 1000000, 4) + "." + to_string_dec_int((f / 100) % 10000, 4, '0');
-	return final_str;
+	FixedString<15> s;
+	format_into(s, fmt::short_freq(f));
+	return s.str();
 }
 
 std::string to_string_short_freq_no_padding(const uint64_t f) {
@@ -147,13 +174,26 @@ static void to_string_hex_internal(char* p, const uint64_t n, const int32_t l) {
 	}
 }
 
-std::string to_string_hex(const uint64_t n, int32_t l) {
+void format_into(StringBuffer& out, const fmt::Hex& field) {
 	char p[32];
 	
-	l = std::min(l, 31L);
-	to_string_hex_internal(p, n, l - 1);
-	p[l] = 0;
-	return p;
+	const int32_t l = std::min(field.l, (int32_t)31);
+	if( l > 0 ) {
+		to_string_hex_internal(p, field.n, l - 1);
+		out += std::string_view { p, static_cast<size_t>(l) };
+	}
+}
+
+std::string to_string_hex(const uint64_t n, int32_t l) {
+	FixedString<31> s;
+	format_into(s, fmt::hex(n, l));
+	return s.str();
+}
+
+void format_into(StringBuffer& out, const fmt::HexArray& field) {
+	for(size_t i = 0; i < field.length; i++) {
+		format_into(out, fmt::hex(field.data[i], 2));
+	}
 }
 
 std::string to_string_hex_array(uint8_t * const array, const int32_t l) {
@@ -166,31 +206,46 @@ std::string to_string_hex_array(uint8_t * const array, const int32_t l) {
 	return str_return;
 }
 
-std::string to_string_datetime(const rtc::RTC& value, const TimeFormat format) {
-	std::string string { "" };
-	
-	if (format == YMDHMS) {
-		string += to_string_dec_uint(value.year(), 4) + "-" +
-					to_string_dec_uint(value.month(), 2, '0') + "-" +
-					to_string_dec_uint(value.day(), 2, '0') + " ";
+void format_into(StringBuffer& out, const fmt::DateTime& field) {
+	const auto& value = field.value;
+
+	if (field.format == YMDHMS) {
+		format_into(out,
+			fmt::dec_uint(value.year(), 4), '-',
+			fmt::dec_uint(value.month(), 2, '0'), '-',
+			fmt::dec_uint(value.day(), 2, '0'), ' '
+		);
 	}
 	
-	string += to_string_dec_uint(value.hour(), 2, '0') + ":" +
-				to_string_dec_uint(value.minute(), 2, '0');
-	
-	if ((format == YMDHMS) || (format == HMS))
-		string += ":" + to_string_dec_uint(value.second(), 2, '0');
+	format_into(out, fmt::dec_uint(value.hour(), 2, '0'), ':', fmt::dec_uint(value.minute(), 2, '0'));
 	
-	return string;
+	if ((field.format == YMDHMS) || (field.format == HMS))
+		format_into(out, ':', fmt::dec_uint(value.second(), 2, '0'));
+}
+
+std::string to_string_datetime(const rtc::RTC& value, const TimeFormat format) {
+	FixedString<19> s;
+	format_into(s, fmt::datetime(value, format));
+	return s.str();
+}
+
+void format_into(StringBuffer& out, const fmt::CompactTimestamp& field) {
+	const auto& value = field.value;
+
+	format_into(out,
+		fmt::dec_uint(value.year(), 4, '0'),
+		fmt::dec_uint(value.month(), 2, '0'),
+		fmt::dec_uint(value.day(), 2, '0'),
+		fmt::dec_uint(value.hour(), 2, '0'),
+		fmt::dec_uint(value.minute(), 2, '0'),
+		fmt::dec_uint(value.second(), 2, '0')
+	);
 }
 
 std::string to_string_timestamp(const rtc::RTC& value) {
-	return to_string_dec_uint(value.year(), 4, '0') +
-		to_string_dec_uint(value.month(), 2, '0') +
-		to_string_dec_uint(value.day(), 2, '0') +
-		to_string_dec_uint(value.hour(), 2, '0') +
-		to_string_dec_uint(value.minute(), 2, '0') +
-		to_string_dec_uint(value.second(), 2, '0');
+	FixedString<14> s;
+	format_into(s, fmt::timestamp(value));
+	return s.str();
 }
 
 std::string to_string_FAT_timestamp(const FATTimestamp& timestamp) {
@@ -201,14 +256,14 @@ std::string to_string_FAT_timestamp(const FATTimestamp& timestamp) {
 		to_string_dec_uint((timestamp.FAT_time >> 5) & 0x3F, 2, '0');
 }
 
-std::string unit_auto_scale(double n, const uint32_t base_nano, uint32_t precision) {
+void format_into(StringBuffer& out, const fmt::UnitAutoScale& field) {
 	const uint32_t powers_of_ten[5] = { 1, 10, 100, 1000, 10000 };
-	std::string string { "" };
-	uint32_t prefix_index = base_nano;
+	double n = field.n;
+	uint32_t prefix_index = field.base_nano;
 	double integer_part;
 	double fractional_part;
 	
-	precision = std::min((uint32_t)4, precision);
+	const uint32_t precision = std::min((uint32_t)4, field.precision);
 	
 	while (n > 1000) {
 		n /= 1000.0;
@@ -219,14 +274,18 @@ std::string unit_auto_scale(double n, const uint32_t base_nano, uint32_t precisi
 	if (fractional_part < 0)
 		fractional_part = -fractional_part;
 	
-	string = to_string_dec_int(integer_part);
+	format_into(out, fmt::dec_int(integer_part));
 	if (precision)
-		string += '.' + to_string_dec_uint(fractional_part, precision);
+		format_into(out, '.', fmt::dec_uint(fractional_part, precision));
 	
 	if (prefix_index != 3)
-		string += unit_prefix[prefix_index];
-	
-	return string;
+		format_into(out, unit_prefix[prefix_index]);
+}
+
+std::string unit_auto_scale(double n, const uint32_t base_nano, uint32_t precision) {
+	FixedString<24> s;
+	format_into(s, fmt::unit_auto_scale(n, base_nano, precision));
+	return s.str();
 }
 
 double get_decimals(double num, int16_t mult, bool round) {
@@ -24,8 +24,10 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "file.hpp"
+#include "fixed_string.hpp"
 
 // BARF! rtc::RTC is leaking everywhere.
 #include "lpc43xx_cpp.hpp"
@@ -56,4 +58,51 @@ std::string to_string_FAT_timestamp(const FATTimestamp& timestamp);
 
 std::string unit_auto_scale(double n, const uint32_t base_nano, uint32_t precision);
 double get_decimals(double num, int16_t mult,  bool round = false); //euquiq added
+
+/* Heap-free counterparts of the to_string_ functions above. Each fmt:: helper
+ * describes a field, and format_into appends any mix of fields, characters
+ * and strings to a StringBuffer (usually a FixedString on the stack):
+ *
+ *   FixedString<32> s;
+ *   format_into(s, fmt::hex(icao, 6), ' ', callsign);
+ */
+namespace fmt {
+
+struct DecUInt { uint32_t n; int32_t l; char fill; };
+struct DecInt { int32_t n; int32_t l; char fill; };
+struct Hex { uint64_t n; int32_t l; };
+struct HexArray { const uint8_t* data; size_t length; };
+struct DateTime { rtc::RTC value; TimeFormat format; };
+struct CompactTimestamp { rtc::RTC value; };
+struct ShortFreq { uint64_t f; };
+struct UnitAutoScale { double n; uint32_t base_nano; uint32_t precision; };
+
+inline DecUInt dec_uint(const uint32_t n, const int32_t l = 0, const char fill = ' ') { return { n, l, fill }; }
+inline DecInt dec_int(const int32_t n, const int32_t l = 0, const char fill = 0) { return { n, l, fill }; }
+inline Hex hex(const uint64_t n, const int32_t l = 0) { return { n, l }; }
+inline HexArray hex_array(const uint8_t* const data, const size_t length) { return { data, length }; }
+inline DateTime datetime(const rtc::RTC& value, const TimeFormat format = YMDHMS) { return { value, format }; }
+inline CompactTimestamp timestamp(const rtc::RTC& value) { return { value }; }
+inline ShortFreq short_freq(const uint64_t f) { return { f }; }
+inline UnitAutoScale unit_auto_scale(const double n, const uint32_t base_nano, const uint32_t precision) { return { n, base_nano, precision }; }
+
+} /* namespace fmt */
+
+void format_into(StringBuffer& out, const std::string_view s);
+void format_into(StringBuffer& out, const char c);
+void format_into(StringBuffer& out, const fmt::DecUInt& field);
+void format_into(StringBuffer& out, const fmt::DecInt& field);
+void format_into(StringBuffer& out, const fmt::Hex& field);
+void format_into(StringBuffer& out, const fmt::HexArray& field);
+void format_into(StringBuffer& out, const fmt::DateTime& field);
+void format_into(StringBuffer& out, const fmt::CompactTimestamp& field);
+void format_into(StringBuffer& out, const fmt::ShortFreq& field);
+void format_into(StringBuffer& out, const fmt::UnitAutoScale& field);
+
+template<typename T1, typename T2, typename... Rest>
+void format_into(StringBuffer& out, const T1& first, const T2& second, const Rest&... rest) {
+	format_into(out, first);
+	format_into(out, second, rest...);
+}
+
 #endif/*__STRING_FORMAT_H__*/
@@ -101,76 +101,22 @@ void TVView::paint(Painter& painter) {
 	(void)painter;
 }
 
-void TVView::on_adjust_xcorr(uint8_t xcorr){
-	x_correction = xcorr;
-}
-
-void TVView::on_channel_spectrum(
-	const ChannelSpectrum& spectrum
-) {
-	//portapack has limitations
-        // 1.screen resolution (less than 240x320) 2.samples each call back (128 or 256)
-	// 3.memory size (for ui::Color, the buffer size
-	//spectrum.db[i] is 256 long
-	//768x625 ->128x625 ->128x312 -> 128x104
-	//originally @6MHz sample rate, the PAL should be 768x625
-        //I reduced sample rate to 2MHz(3 times less samples), then calculate mag (effectively decimate by 2)
-	//the resolution is now changed to 128x625. The total decimation factor is 6, which changes how many samples in a line
-	//However 625 is too large for the screen, also interlaced scanning is harder to realize in portapack than normal computer.
-        //So I decided to simply drop half of the lines, once y is larger than 625/2=312.5 or 312, I recognize it as a new frame.
-        //then the resolution is changed to 128x312
-        //128x312 is now able to put into a 240x320 screen, but the buffer for a whole frame is 128x312=39936, which is too large
-        //according to my test, I can only make a buffer with a length of 13312 of type ui::Color. which is 1/3 of what I wanted.
-        //So now the resolution is changed to 128x104, the height is shrinked to 1/3 of the original height.
-        //I was expecting to see 1/3 height of original video.
-
-        //Look how nice is that! I am now able to meet the requirements of 1 and 3 for portapack. Also the length of a line is 128
-        //Each call back gives me 256 samples which is exactly 2 lines. What a coincidence!
-
-	//After some experiment, I did some improvements.
-	//1.I found that instead of 1/3 of the frame is shown, I got 3 whole frames shrinked into one window.
-	//So I made the height twice simply by painting 2 identical lines in the place of original lines
-	//2.I found sometimes there is an horizontal offset, so I added x_correction to move the frame back to center manually
-	//3.I changed video_buffer's type, from ui::Color to uint_8, since I don't need 3 digit to represent a grey scale value.
-	//I was hoping that by doing this, I can have a longer buffer like 39936, then the frame will looks better vertically
-	//however this is useless until now.	
-
-	for(size_t i=0; i<256; i++) 
-	{
-		//video_buffer[i+count*256] = spectrum_rgb4_lut[spectrum.db[i]];
-		video_buffer_int[i+count*256] = 255 - spectrum.db[i];
+void TVView::on_line(const TVLine& line) {
+	// Lines come sync-aligned from the baseband, each one is drawn twice at its own row
+	std::array<Color, TVLine::width> line_buffer;
+	for(size_t x=0; x<TVLine::width; x++) {
+		line_buffer[x] = spectrum_rgb4_lut[line.pixels[x]];
 	}
-	count = count + 1;
-	if (count == 52 -1)
-	{
-		ui::Color line_buffer[128];
-		Coord line;
-		uint32_t bmp_px;
-
-		/*for (line = 0; line < 104; line++)
-		{
-			for (bmp_px = 0; bmp_px < 128; bmp_px++) 
-			{
-				//line_buffer[bmp_px] = video_buffer[bmp_px+line*128];
-				line_buffer[bmp_px] = spectrum_rgb4_lut[video_buffer_int[bmp_px+line*128 + x_correction]];
-			}
-
-			display.render_line({ 0, line + 100 }, 128, line_buffer);
-		}*/
-		for (line = 0; line < 208; line=line+2)
-		{
-			for (bmp_px = 0; bmp_px < 128; bmp_px++) 
-			{
-				//line_buffer[bmp_px] = video_buffer[bmp_px+line*128];
-				line_buffer[bmp_px] = spectrum_rgb4_lut[video_buffer_int[bmp_px+line/2*128 + x_correction]];
-			}
-
-			display.render_line({ 0, line + 100 }, 128, line_buffer);
-			display.render_line({ 0, line + 101 }, 128, line_buffer);
-		}
-		count = 0;
+
+	const auto r = screen_rect();
+	const Coord y = r.top() + line.row * 2;
+	if( y + 1 >= r.bottom() ) {
+		return;
 	}
 
+	const Coord x = r.left() + (r.width() - TVLine::width) / 2;
+	display.render_line({ x, y }, TVLine::width, line_buffer.data());
+	display.render_line({ x, y + 1 }, TVLine::width, line_buffer.data());
 }
 
 void TVView::clear() {
@@ -184,10 +130,8 @@ void TVView::clear() {
 
 TVWidget::TVWidget() {
 	add_children({
-		&tv_view,
-		&field_xcorr
+		&tv_view
 	});
-	field_xcorr.set_value(10);
 }
 
 void TVWidget::on_show() {
@@ -236,13 +180,6 @@ void TVWidget::paint(Painter& painter) {
 	(void)painter;
 }
 
-void TVWidget::on_channel_spectrum(const ChannelSpectrum& spectrum) {
-	tv_view.on_channel_spectrum(spectrum);
-	tv_view.on_adjust_xcorr(field_xcorr.value());
-	sampling_rate = spectrum.sampling_rate;
-	
-}
-
 void TVWidget::on_audio_spectrum() {
 	audio_spectrum_view->on_audio_spectrum(audio_spectrum_data);
 }
@@ -77,12 +77,8 @@ public:
 	void on_hide() override;
 
 	void paint(Painter& painter) override;
-	void on_channel_spectrum(const ChannelSpectrum& spectrum);
-	void on_adjust_xcorr(uint8_t xcorr);
-	//ui::Color video_buffer[13312];
-        uint8_t video_buffer_int[13312+128] { 0 }; //128 is for the over length caused by x_correction
-	uint32_t count=0;
-        uint8_t x_correction=0;
+	void on_line(const TVLine& line);
+
 private:
 	void clear();
 	
@@ -107,13 +103,6 @@ public:
 	void show_audio_spectrum_view(const bool show);
 
 	void paint(Painter& painter) override;
-	NumberField field_xcorr {
-		{ 0 * 8, 0 * 16 },
-		5,
-		{ 0, 128 },
-		1,
-		' '
-	};
 
 private:
 	void update_widgets_rect();
@@ -124,22 +113,21 @@ private:
 	
 	TVView tv_view { };
 
-	ChannelSpectrumFIFO* channel_fifo { nullptr };
+	TVLineFIFO* line_fifo { nullptr };
 	AudioSpectrum* audio_spectrum_data { nullptr };
 	bool audio_spectrum_update { false };
 	
 	std::unique_ptr<TimeScopeView> audio_spectrum_view { };
 	
-	int sampling_rate { 0 };
 	int32_t cursor_position { 0 };
 	ui::Rect tv_normal_rect { };
 	ui::Rect tv_reduced_rect { };
 
-	MessageHandlerRegistration message_handler_channel_spectrum_config {
-		Message::ID::ChannelSpectrumConfig,
+	MessageHandlerRegistration message_handler_lines_config {
+		Message::ID::TVLinesConfig,
 		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ChannelSpectrumConfigMessage*>(p);
-			this->channel_fifo = message.fifo;
+			const auto message = *reinterpret_cast<const TVLinesConfigMessage*>(p);
+			this->line_fifo = message.fifo;
 		}
 	};
 	MessageHandlerRegistration message_handler_audio_spectrum {
@@ -153,10 +141,10 @@ private:
 	MessageHandlerRegistration message_handler_frame_sync {
 		Message::ID::DisplayFrameSync,
 		[this](const Message* const) {
-			if( this->channel_fifo ) {
-				ChannelSpectrum channel_spectrum;
-				while( channel_fifo->out(channel_spectrum) ) {
-					this->on_channel_spectrum(channel_spectrum);
+			if( this->line_fifo ) {
+				TVLine line;
+				while( line_fifo->out(line) ) {
+					this->tv_view.on_line(line);
 				}
 			}
 			if (this->audio_spectrum_update) {
@@ -166,7 +154,6 @@ private:
 		}
 	};
 
-	void on_channel_spectrum(const ChannelSpectrum& spectrum);
 	void on_audio_spectrum();
 };
 
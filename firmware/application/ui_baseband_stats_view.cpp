@@ -36,7 +36,13 @@ namespace ui {
 BasebandStatsView::BasebandStatsView() {
 	add_children({
 		&text_stats,
+		&labels_profile,
 	});
+
+	for(size_t i=0; i<text_profile.size(); i++) {
+		text_profile[i].set_parent_rect({ 8 * 8, static_cast<Coord>((2 + i) * 16), 14 * 8, 1 * 16 });
+		add_child(&text_profile[i]);
+	}
 }
 
 static std::string ticks_to_percent_string(const uint32_t ticks) {
@@ -57,6 +63,26 @@ void BasebandStatsView::on_statistics_update(const BasebandStatistics& statistic
 		+ " " + ticks_to_percent_string(statistics.baseband_ticks);
 
 	text_stats.set(message);
+
+	on_profile_update();
+}
+
+static std::string cycles_to_us_string(const uint32_t cycles) {
+	return to_string_dec_uint(cycles / (base_m4_clk_f / 1000000), 4);
+}
+
+void BasebandStatsView::on_profile_update() {
+	// Published by the M4 just before the statistics message
+	const auto& profile = shared_memory.baseband_profile;
+
+	for(size_t i=0; i<text_profile.size(); i++) {
+		const auto& cycles = (i == 0) ? profile.block : profile.stages[i - 1];
+		text_profile[i].set(
+			cycles_to_us_string(cycles.min) + " " +
+			cycles_to_us_string(cycles.avg) + " " +
+			cycles_to_us_string(cycles.max)
+		);
+	}
 }
 
 } /* namespace ui */
@@ -27,6 +27,9 @@
 #include "event_m0.hpp"
 
 #include "message.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <array>
 
 namespace ui {
 
@@ -40,6 +43,19 @@ private:
 		"",
 	};
 
+	// Cycle profile of the running processor, rows follow BasebandProfile::Stage
+	Labels labels_profile {
+		{ { 0 * 8, 1 * 16 }, "us/block min  avg  max", Color::light_grey() },
+		{ { 0 * 8, 2 * 16 }, "Total", Color::light_grey() },
+		{ { 0 * 8, 3 * 16 }, "Decim", Color::light_grey() },
+		{ { 0 * 8, 4 * 16 }, "Filter", Color::light_grey() },
+		{ { 0 * 8, 5 * 16 }, "Demod", Color::light_grey() },
+		{ { 0 * 8, 6 * 16 }, "Audio", Color::light_grey() },
+		{ { 0 * 8, 7 * 16 }, "Spectrum", Color::light_grey() },
+	};
+
+	std::array<Text, BasebandProfile::stage_count + 1> text_profile { };
+
 	MessageHandlerRegistration message_handler_stats {
 		Message::ID::BasebandStatistics,
 		[this](const Message* const p) {
@@ -48,6 +64,7 @@ private:
 	};
 
 	void on_statistics_update(const BasebandStatistics& statistics);
+	void on_profile_update();
 };
 
 } /* namespace ui */
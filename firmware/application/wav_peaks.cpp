@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "wav_peaks.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <cstring>
+
+namespace {
+
+constexpr char peaks_magic[4] { 'P', 'K', 'S', '1' };
+
+using Peak = WAVPeaks::Peak;
+
+Peak merge(const Peak a, const Peak b) {
+	return { std::min(a.min, b.min), std::max(a.max, b.max) };
+}
+
+// Top 8 bits of a sample, as signed
+int8_t sample_value(const uint8_t* const p, const size_t bytes) {
+	if (bytes == 2)
+		return static_cast<int8_t>(p[1]);		// 16-bit signed, little endian
+	else
+		return static_cast<int8_t>(p[0] ^ 0x80);	// 8-bit unsigned
+}
+
+/* Sequential sample reader over the WAV data chunk, stops at sample_count
+ * even if other chunks follow the data.
+ */
+class SampleStream {
+public:
+	SampleStream(
+		WAVFileReader& reader,
+		const uint64_t first_sample,
+		const uint64_t sample_count,
+		const size_t bytes_per_sample
+	) : reader { reader },
+		remaining { (first_sample < sample_count) ? sample_count - first_sample : 0 },
+		bytes { bytes_per_sample }
+	{
+		reader.data_seek(first_sample);
+	}
+
+	bool next(int8_t& value) {
+		if (!remaining)
+			return false;
+
+		if (pos >= fill) {
+			const auto result = reader.read(buffer.data(), buffer.size());
+			if (result.is_error() || (result.value() < bytes)) {
+				remaining = 0;
+				return false;
+			}
+			fill = result.value();
+			pos = 0;
+		}
+
+		value = sample_value(&buffer[pos], bytes);
+		pos += bytes;
+		remaining--;
+		return true;
+	}
+
+private:
+	WAVFileReader& reader;
+	uint64_t remaining;
+	const size_t bytes;
+	std::array<uint8_t, 512> buffer { };
+	size_t fill { 0 };
+	size_t pos { 0 };
+};
+
+/* Peaks come in at level 0 and pairs cascade upwards as they complete.
+ * Each level writes through a small buffer to its own region of the file.
+ */
+class PyramidWriter {
+public:
+	PyramidWriter(
+		File& file,
+		const size_t levels,
+		const uint32_t* const level_offset
+	) : file { file },
+		levels { levels },
+		level_offset { level_offset }
+	{
+	}
+
+	bool push(const size_t level, const Peak peak) {
+		auto& s = state[level];
+
+		s.buffer[s.buffered++] = peak;
+		if ((s.buffered == s.buffer.size()) && !flush(level))
+			return false;
+
+		if (level + 1 < levels) {
+			if (s.has_carry) {
+				s.has_carry = false;
+				return push(level + 1, merge(s.carry, peak));
+			}
+			s.carry = peak;
+			s.has_carry = true;
+		}
+		return true;
+	}
+
+	// An unpaired last peak goes up as is
+	bool finish() {
+		for (size_t level = 0; level < levels; level++) {
+			auto& s = state[level];
+			if (s.has_carry) {
+				s.has_carry = false;
+				if (!push(level + 1, s.carry))
+					return false;
+			}
+			if (!flush(level))
+				return false;
+		}
+		return true;
+	}
+
+private:
+	struct LevelState {
+		std::array<Peak, 16> buffer;
+		size_t buffered;
+		uint32_t written;
+		Peak carry;
+		bool has_carry;
+	};
+
+	File& file;
+	const size_t levels;
+	const uint32_t* const level_offset;
+	std::array<LevelState, 32> state { };
+
+	bool flush(const size_t level) {
+		auto& s = state[level];
+		if (!s.buffered)
+			return true;
+
+		if (file.seek(level_offset[level] + s.written * sizeof(Peak)).is_error())
+			return false;
+		const auto result = file.write(s.buffer.data(), s.buffered * sizeof(Peak));
+		if (result.is_error() || (result.value() != s.buffered * sizeof(Peak)))
+			return false;
+
+		s.written += s.buffered;
+		s.buffered = 0;
+		return true;
+	}
+};
+
+} /* namespace */
+
+bool WAVPeaks::open(WAVFileReader& wav_reader, const std::filesystem::path& wav_path) {
+	reader = &wav_reader;
+	bits_per_sample = reader->bits_per_sample();
+	has_pyramid = false;
+	levels = 0;
+	cache_level = max_levels;
+
+	if ((bits_per_sample != 8) && (bits_per_sample != 16))
+		return false;
+
+	layout(reader->data_size());
+	if (!levels)
+		return false;
+
+	auto peaks_path = wav_path;
+	peaks_path.replace_extension(u".PKS");
+
+	if (!check(peaks_path) && !build(peaks_path)) {
+		delete_file(peaks_path);
+		return true;
+	}
+
+	has_pyramid = !file.open(peaks_path).is_valid();
+	return true;
+}
+
+void WAVPeaks::layout(const uint32_t data_size) {
+	sample_count_ = data_size / (bits_per_sample / 8);
+	levels = 0;
+
+	uint32_t count = (sample_count_ + block_size - 1) / block_size;
+	uint32_t offset = sizeof(header_t);
+	while (count && (levels < max_levels)) {
+		level_offset[levels] = offset;
+		level_count[levels] = count;
+		levels++;
+		offset += count * sizeof(Peak);
+		if (count == 1)
+			break;
+		count = (count + 1) / 2;
+	}
+}
+
+bool WAVPeaks::check(const std::filesystem::path& path) {
+	File peaks_file;
+	header_t header;
+
+	if (peaks_file.open(path).is_valid())
+		return false;
+
+	const auto expected_size = level_offset[levels - 1] + level_count[levels - 1] * sizeof(Peak);
+	if (peaks_file.size() != expected_size)
+		return false;
+
+	const auto result = peaks_file.read(&header, sizeof(header));
+	if (result.is_error() || (result.value() != sizeof(header)))
+		return false;
+
+	return !memcmp(header.magic, peaks_magic, sizeof(peaks_magic)) &&
+		(header.data_size == reader->data_size()) &&
+		(header.bits_per_sample == bits_per_sample) &&
+		(header.block_size == block_size);
+}
+
+bool WAVPeaks::build(const std::filesystem::path& path) {
+	File peaks_file;
+	header_t header { };
+
+	if (peaks_file.create(path).is_valid())
+		return false;
+
+	memcpy(header.magic, peaks_magic, sizeof(peaks_magic));
+	header.data_size = reader->data_size();
+	header.bits_per_sample = bits_per_sample;
+	header.block_size = block_size;
+	if (peaks_file.write(&header, sizeof(header)).is_error())
+		return false;
+
+	// ~1.3KB of level state, keep it off the stack
+	auto writer = std::make_unique<PyramidWriter>(peaks_file, levels, level_offset.data());
+	auto stream = std::make_unique<SampleStream>(*reader, 0, sample_count_, bits_per_sample / 8);
+
+	int8_t value;
+	for (uint32_t block = 0; block < level_count[0]; block++) {
+		Peak peak { 127, -128 };
+		for (uint32_t n = 0; (n < block_size) && stream->next(value); n++) {
+			peak.min = std::min(peak.min, value);
+			peak.max = std::max(peak.max, value);
+		}
+		if (peak.min > peak.max)
+			peak = { 0, 0 };	// File shorter than its header says
+
+		if (!writer->push(0, peak))
+			return false;
+	}
+
+	return writer->finish() && !peaks_file.sync().is_valid();
+}
+
+WAVPeaks::Peak WAVPeaks::entry(const size_t level, const uint32_t index) {
+	if ((level != cache_level) || (index < cache_first) || (index >= cache_first + cache_size)) {
+		const auto count = std::min<uint32_t>(cache_size, level_count[level] - index);
+		cache_level = max_levels;
+		if (file.seek(level_offset[level] + index * sizeof(Peak)).is_error())
+			return { 0, 0 };
+		const auto result = file.read(cache.data(), count * sizeof(Peak));
+		if (result.is_error() || (result.value() != count * sizeof(Peak)))
+			return { 0, 0 };
+		cache_level = level;
+		cache_first = index;
+	}
+
+	return cache[index - cache_first];
+}
+
+void WAVPeaks::read(const uint64_t first_sample, const uint32_t samples_per_peak, Peak* out, const size_t count) {
+	if (!levels || !samples_per_peak)
+		return;
+
+	// Below one block per peak, the pyramid has nothing to offer
+	if (!has_pyramid || (samples_per_peak < block_size)) {
+		read_samples(first_sample, samples_per_peak, out, count);
+		return;
+	}
+
+	// Coarsest level whose entries still fit in one output peak
+	size_t level = 0;
+	while ((level + 1 < levels) && ((uint64_t)block_size << (level + 1)) <= samples_per_peak)
+		level++;
+	const uint64_t span = (uint64_t)block_size << level;
+
+	for (size_t i = 0; i < count; i++) {
+		const uint64_t start = first_sample + (uint64_t)i * samples_per_peak;
+		if (start >= sample_count_) {
+			out[i] = { 0, 0 };
+			continue;
+		}
+
+		const uint64_t end = std::min<uint64_t>((start + samples_per_peak + span - 1) / span, level_count[level]);
+		uint32_t index = start / span;
+		Peak peak = entry(level, index++);
+		for (; index < end; index++)
+			peak = merge(peak, entry(level, index));
+		out[i] = peak;
+	}
+}
+
+void WAVPeaks::read_samples(const uint64_t first_sample, const uint32_t samples_per_peak, Peak* out, const size_t count) {
+	auto stream = std::make_unique<SampleStream>(*reader, first_sample, sample_count_, bits_per_sample / 8);
+	int8_t value;
+
+	for (size_t i = 0; i < count; i++) {
+		Peak peak { 127, -128 };
+		for (uint32_t n = 0; (n < samples_per_peak) && stream->next(value); n++) {
+			peak.min = std::min(peak.min, value);
+			peak.max = std::max(peak.max, value);
+		}
+		out[i] = (peak.min > peak.max) ? Peak { 0, 0 } : peak;
+	}
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __WAV_PEAKS_H__
+#define __WAV_PEAKS_H__
+
+#include "io_wave.hpp"
+#include "file.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* Min/max envelope of a WAV file, kept as a pyramid in a .PKS file next to it.
+ * Level 0 holds one peak per block_size samples, each level above merges
+ * pairs of the level below until a single peak covers the whole file.
+ * The sidecar is rebuilt in one sequential pass whenever it is missing or
+ * doesn't match the WAV (data size, sample format).
+ * If the sidecar can't be written, read() falls back to scanning the samples.
+ * Peaks are signed 8-bit whatever the WAV format, channels are not split.
+ */
+class WAVPeaks {
+public:
+	struct Peak {
+		int8_t min;
+		int8_t max;
+	};
+
+	static constexpr uint32_t block_size = 256;
+
+	WAVPeaks() = default;
+
+	WAVPeaks(const WAVPeaks&) = delete;
+	WAVPeaks& operator=(const WAVPeaks&) = delete;
+
+	// Returns false for unsupported formats, the reader must stay open while read() is used
+	bool open(WAVFileReader& reader, const std::filesystem::path& wav_path);
+
+	// Fills count peaks, each one covering samples_per_peak samples
+	void read(const uint64_t first_sample, const uint32_t samples_per_peak, Peak* out, const size_t count);
+
+	uint64_t sample_count() const {
+		return sample_count_;
+	}
+
+private:
+	static constexpr size_t max_levels = 32;
+	static constexpr size_t cache_size = 64;
+
+	struct header_t {
+		char magic[4];
+		uint32_t data_size;
+		uint16_t bits_per_sample;
+		uint16_t block_size;
+	};
+
+	WAVFileReader* reader { nullptr };
+	File file { };
+	bool has_pyramid { false };
+	uint64_t sample_count_ { 0 };
+	uint16_t bits_per_sample { 0 };
+	size_t levels { 0 };
+	std::array<uint32_t, max_levels> level_offset { };
+	std::array<uint32_t, max_levels> level_count { };
+
+	std::array<Peak, cache_size> cache { };
+	size_t cache_level { max_levels };
+	uint32_t cache_first { 0 };
+
+	void layout(const uint32_t data_size);
+	bool check(const std::filesystem::path& path);
+	bool build(const std::filesystem::path& path);
+	Peak entry(const size_t level, const uint32_t index);
+	void read_samples(const uint64_t first_sample, const uint32_t samples_per_peak, Peak* out, const size_t count);
+};
+
+#endif/*__WAV_PEAKS_H__*/
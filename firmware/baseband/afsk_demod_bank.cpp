@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ * Copyright (C) 2016 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "afsk_demod_bank.hpp"
+
+#include "sine_table_int8.hpp"
+
+#include "hal.h"
+
+// Space energy weights of the tilt slicers, -6dB to +6dB
+static constexpr std::array<float, AFSKDemodBank::tilt_count> tilt_gains { {
+	0.25f, 0.5f, 1.0f, 2.0f, 4.0f
+} };
+
+// AFSKSlicer ////////////////////////////////////////////////////////////
+
+bool AFSKSlicer::execute(const float value, const uint32_t phase_inc) {
+	const uint8_t bit = (value > 0.0f) ? 1 : 0;
+
+	// Transitions belong half-way between two sampling points
+	if (bit != last_bit) {
+		const int32_t error = 0x8000 - static_cast<int32_t>(phase);
+		phase += error / 4;
+		last_bit = bit;
+	}
+
+	phase += phase_inc;
+	if (phase < 0x10000)
+		return false;
+
+	phase &= 0xFFFF;
+	return deframer_.execute(bit);
+}
+
+// AFSKDemodBank /////////////////////////////////////////////////////////
+
+void AFSKDemodBank::configure(const uint32_t sampling_rate, const uint32_t baudrate) {
+	samples_per_bit = sampling_rate / baudrate;
+	if (samples_per_bit > history_size)
+		samples_per_bit = history_size;
+
+	phase_inc = (0x10000 * baudrate) / sampling_rate;
+	mark_phase_inc = (static_cast<uint64_t>(mark_frequency) << 32) / sampling_rate;
+	space_phase_inc = (static_cast<uint64_t>(space_frequency) << 32) / sampling_rate;
+
+	history_index = 0;
+	delay_line.fill(0);
+	products.fill({ });
+	sums.fill(0);
+	slicers.fill({ });
+}
+
+float AFSKDemodBank::delay_line_value(const int32_t sample) {
+	delay_line[history_index & history_mask] = sample;
+
+	// Mark (1200Hz) comes out negative after half a bit of delay, space positive
+	const int32_t mixed = (delay_line[(history_index - (samples_per_bit / 2)) & history_mask] * sample) / 4;
+	const int32_t filtered = prev_mixed + mixed + (prev_filtered / 2);
+	prev_mixed = mixed;
+	prev_filtered = filtered;
+
+	return -20 - filtered;
+}
+
+uint32_t AFSKDemodBank::execute(const float sample) {
+	const int32_t sample_int = __SSAT(static_cast<int32_t>(sample * 32768.0f), 16) / 128;
+	uint32_t frames = 0;
+
+	if (slicers[0].execute(delay_line_value(sample_int), phase_inc))
+		frames |= 1;
+
+	// Sliding correlation: add the newest products, drop the ones a bit old
+	auto& newest = products[history_index & history_mask];
+	const auto& oldest = products[(history_index - samples_per_bit) & history_mask];
+	for (size_t i = 0; i < sums.size(); i++)
+		sums[i] -= oldest[i];
+
+	const uint8_t m = mark_phase >> 24;
+	const uint8_t s = space_phase >> 24;
+	newest[0] = sample_int * sine_table_i8[(m + 64) & 0xFF];
+	newest[1] = sample_int * sine_table_i8[m];
+	newest[2] = sample_int * sine_table_i8[(s + 64) & 0xFF];
+	newest[3] = sample_int * sine_table_i8[s];
+	for (size_t i = 0; i < sums.size(); i++)
+		sums[i] += newest[i];
+
+	mark_phase += mark_phase_inc;
+	space_phase += space_phase_inc;
+	history_index++;
+
+	const float mark_energy = (float)sums[0] * sums[0] + (float)sums[1] * sums[1];
+	const float space_energy = (float)sums[2] * sums[2] + (float)sums[3] * sums[3];
+
+	for (size_t i = 0; i < tilt_count; i++) {
+		if (slicers[i + 1].execute(mark_energy - space_energy * tilt_gains[i], phase_inc))
+			frames |= 1 << (i + 1);
+	}
+
+	return frames;
+}
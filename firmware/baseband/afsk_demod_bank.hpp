@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ * Copyright (C) 2016 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __AFSK_DEMOD_BANK_H__
+#define __AFSK_DEMOD_BANK_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "hdlc_deframer.hpp"
+
+/* Bit clock recovery for one decision signal: a positive value slices to 1,
+ * sign changes pull the sampling point half a bit away from them.
+ */
+class AFSKSlicer {
+public:
+	// True when a frame just ended, see deframer()
+	bool execute(const float value, const uint32_t phase_inc);
+
+	const hdlc::Deframer& deframer() const {
+		return deframer_;
+	}
+
+private:
+	uint32_t phase { 0 };
+	uint8_t last_bit { 0 };
+	hdlc::Deframer deframer_ { };
+};
+
+/* AFSK1200 demodulator bank, after the multi-decoder TNCs. Each sample feeds:
+ * - the delay-line discriminator, with one slicer,
+ * - sliding mark and space correlators over one bit (a Goertzel in effect,
+ *   updated every sample) with tilt_count slicers, each weighing mark against
+ *   space with a different gain to cope with de-emphasised or twisted audio.
+ * Every slicer has its own clock recovery and deframer, so the same frame
+ * usually comes out of several of them: the caller has to drop duplicates.
+ *
+ * Cost grows with tilt_count, the processor times the whole bank as its Demod
+ * profile stage.
+ */
+class AFSKDemodBank {
+public:
+	static constexpr size_t tilt_count = 5;
+	static constexpr size_t slicer_count = tilt_count + 1;
+
+	void configure(const uint32_t sampling_rate, const uint32_t baudrate);
+
+	// Bit n set if slicer n just ended a frame
+	uint32_t execute(const float sample);
+
+	const hdlc::Deframer& deframer(const size_t index) const {
+		return slicers[index].deframer();
+	}
+
+private:
+	static constexpr uint32_t mark_frequency = 1200;
+	static constexpr uint32_t space_frequency = 2200;
+
+	// Ok down to 375 bauds at 24kHz
+	static constexpr size_t history_size = 64;
+	static constexpr size_t history_mask = history_size - 1;
+
+	uint32_t phase_inc { 0 };
+	size_t samples_per_bit { 1 };
+	size_t history_index { 0 };
+
+	// Delay-line discriminator
+	std::array<int32_t, history_size> delay_line { };
+	int32_t prev_mixed { 0 };
+	int32_t prev_filtered { 0 };
+
+	// Mark I/Q, space I/Q products and their sums over the last bit
+	std::array<std::array<int32_t, 4>, history_size> products { };
+	std::array<int32_t, 4> sums { };
+	uint32_t mark_phase { 0 };
+	uint32_t mark_phase_inc { 0 };
+	uint32_t space_phase { 0 };
+	uint32_t space_phase_inc { 0 };
+
+	std::array<AFSKSlicer, slicer_count> slicers { };
+
+	float delay_line_value(const int32_t sample);
+};
+
+#endif/*__AFSK_DEMOD_BANK_H__*/
@@ -79,7 +79,8 @@ void _default_exit(void) {
 	ShutdownMessage shutdown_message;
 	shared_memory.application_queue.push(shutdown_message);
 
-	shared_memory.baseband_message = nullptr;
+	// Everything the M0 queued is done with now, including the shutdown
+	shared_memory.baseband_completed = shared_memory.baseband_queued;
 
 	halt();
 }
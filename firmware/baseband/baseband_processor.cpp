@@ -33,4 +33,5 @@ void BasebandProcessor::feed_channel_stats(const buffer_c16_t& channel) {
 			shared_memory.application_queue.push(channel_stats_message);
 		}
 	);
+	scan_measurement.feed(channel);
 }
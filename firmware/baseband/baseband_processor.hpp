@@ -25,6 +25,7 @@
 #include "dsp_types.hpp"
 
 #include "channel_stats_collector.hpp"
+#include "scan_measurement_collector.hpp"
 
 #include "message.hpp"
 
@@ -41,6 +42,7 @@ protected:
 
 private:
 	ChannelStatsCollector channel_stats { };
+	ScanMeasurementCollector scan_measurement { };
 };
 
 #endif/*__BASEBAND_PROCESSOR_H__*/
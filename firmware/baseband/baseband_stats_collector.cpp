@@ -21,6 +21,11 @@
 
 #include "baseband_stats_collector.hpp"
 
+#include "event_m4.hpp"
+#include "rssi_thread.hpp"
+#include "baseband_thread.hpp"
+#include "cycle_profiler.hpp"
+
 #include "lpc43xx_cpp.hpp"
 
 bool BasebandStatsCollector::process(const buffer_c8_t& buffer) {
@@ -31,28 +36,29 @@ bool BasebandStatsCollector::process(const buffer_c8_t& buffer) {
 	return report_delta >= report_samples;
 }
 
+static uint32_t ticks_since(const Thread* const thread, uint32_t& last_ticks) {
+	if( !thread ) {
+		return 0;
+	}
+	const auto ticks = thread->total_ticks;
+	const auto delta = ticks - last_ticks;
+	last_ticks = ticks;
+	return delta;
+}
+
 BasebandStatistics BasebandStatsCollector::capture_statistics() {
 	BasebandStatistics statistics;
 
-	const auto idle_ticks = thread_idle->total_ticks;
-	statistics.idle_ticks = (idle_ticks - last_idle_ticks);
-	last_idle_ticks = idle_ticks;
-
-	const auto main_ticks = thread_main->total_ticks;
-	statistics.main_ticks = (main_ticks - last_main_ticks);
-	last_main_ticks = main_ticks;
-
-	const auto rssi_ticks = thread_rssi->total_ticks;
-	statistics.rssi_ticks = (rssi_ticks - last_rssi_ticks);
-	last_rssi_ticks = rssi_ticks;
-
-	const auto baseband_ticks = thread_baseband->total_ticks;
-	statistics.baseband_ticks = (baseband_ticks - last_baseband_ticks);
-	last_baseband_ticks = baseband_ticks;
+	statistics.idle_ticks = ticks_since(chSysGetIdleThread(), last_idle_ticks);
+	statistics.main_ticks = ticks_since(EventDispatcher::event_loop_thread(), last_main_ticks);
+	statistics.rssi_ticks = ticks_since(RSSIThread::running_thread(), last_rssi_ticks);
+	statistics.baseband_ticks = ticks_since(BasebandThread::running_thread(), last_baseband_ticks);
 
 	statistics.saturation = lpc43xx::m4::flag_saturation();
 	lpc43xx::m4::clear_flag_saturation();
 
+	profile::publish();
+
 	samples_last_report = samples;
 
 	return statistics;
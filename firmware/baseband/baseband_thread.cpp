@@ -32,6 +32,9 @@
 using namespace lpc43xx;
 
 #include "portapack_shared_memory.hpp"
+#include "baseband_stats_collector.hpp"
+#include "cycle_profiler.hpp"
+#include "packet_batch.hpp"
 
 #include "utility.hpp"
 
@@ -79,6 +82,8 @@ void BasebandThread::run() {
 	);
 	//baseband::dma::allocate(4, 2048);
 
+	BasebandStatsCollector stats;
+
 	baseband_sgpio.configure(direction());
 	baseband::dma::enable(direction());
 	baseband_sgpio.streaming_enable();
@@ -92,11 +97,24 @@ void BasebandThread::run() {
 			};
 
 			if( baseband_processor ) {
+				const auto start = profile::now();
 				baseband_processor->execute(buffer);
+				profile::block_done(start);
 			}
+
+			packet_batch::poll();
+
+			stats.process(buffer,
+				[](const BasebandStatistics& statistics) {
+					const BasebandStatisticsMessage message { statistics };
+					shared_memory.application_queue.push(message);
+				}
+			);
 		}
 	}
 
+	packet_batch::flush();
+
 	i2s::i2s0::tx_mute();
 	baseband::dma::disable();
 	baseband_sgpio.streaming_disable();
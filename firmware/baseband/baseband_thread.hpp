@@ -51,6 +51,10 @@ public:
 	
 	void set_sampling_rate(uint32_t new_sampling_rate);
 
+	static const Thread* running_thread() {
+		return thread;
+	}
+
 private:
 	static Thread* thread;
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "cycle_profiler.hpp"
+
+#include <limits>
+
+namespace profile {
+
+std::array<uint32_t, BasebandProfile::stage_count> stage_start { };
+std::array<uint32_t, BasebandProfile::stage_count> block_cycles { };
+
+class Accumulator {
+public:
+	void feed(const uint32_t cycles) {
+		if( cycles < min ) {
+			min = cycles;
+		}
+		if( cycles > max ) {
+			max = cycles;
+		}
+		sum += cycles;
+	}
+
+	ProfileCycles take(const uint32_t count) {
+		const ProfileCycles result { min, sum / count, max };
+		min = std::numeric_limits<uint32_t>::max();
+		max = 0;
+		sum = 0;
+		return result;
+	}
+
+private:
+	uint32_t min { std::numeric_limits<uint32_t>::max() };
+	uint32_t max { 0 };
+	uint32_t sum { 0 };
+};
+
+static Accumulator block_accumulator { };
+static std::array<Accumulator, BasebandProfile::stage_count> stage_accumulators { };
+static uint32_t block_count { 0 };
+
+void block_done(const uint32_t start) {
+	block_accumulator.feed(now() - start);
+	for(size_t i=0; i<block_cycles.size(); i++) {
+		stage_accumulators[i].feed(block_cycles[i]);
+		block_cycles[i] = 0;
+	}
+	block_count++;
+}
+
+void publish() {
+	if( !block_count ) {
+		return;
+	}
+
+	auto& profile = shared_memory.baseband_profile;
+	profile.block_count = block_count;
+	profile.block = block_accumulator.take(block_count);
+	for(size_t i=0; i<stage_accumulators.size(); i++) {
+		profile.stages[i] = stage_accumulators[i].take(block_count);
+	}
+	profile.update_count++;
+
+	block_count = 0;
+}
+
+} /* namespace profile */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __CYCLE_PROFILER_H__
+#define __CYCLE_PROFILER_H__
+
+#include "hal.h"
+
+#include "portapack_shared_memory.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* DWT cycle counter timing of processor stages, e.g.:
+ *
+ *   PROFILE_BEGIN(Filter);
+ *   const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);
+ *   PROFILE_END(Filter);
+ *
+ * A stage may be timed more than once per block, the cycles add up.
+ */
+#define PROFILE_BEGIN(stage)	profile::begin(BasebandProfile::Stage::stage)
+#define PROFILE_END(stage)		profile::end(BasebandProfile::Stage::stage)
+
+namespace profile {
+
+extern std::array<uint32_t, BasebandProfile::stage_count> stage_start;
+extern std::array<uint32_t, BasebandProfile::stage_count> block_cycles;
+
+inline uint32_t now() {
+	return halGetCounterValue();
+}
+
+inline void begin(const BasebandProfile::Stage stage) {
+	stage_start[static_cast<size_t>(stage)] = now();
+}
+
+inline void end(const BasebandProfile::Stage stage) {
+	const auto index = static_cast<size_t>(stage);
+	block_cycles[index] += now() - stage_start[index];
+}
+
+// Called by BasebandThread after each execute()
+void block_done(const uint32_t start);
+
+// Writes min/avg/max since the last call to shared_memory.baseband_profile
+void publish();
+
+} /* namespace profile */
+
+#endif/*__CYCLE_PROFILER_H__*/
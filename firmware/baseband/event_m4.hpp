@@ -49,6 +49,10 @@ public:
 		chEvtSignalI(thread_event_loop, events);
 	}
 
+	static const Thread* event_loop_thread() {
+		return thread_event_loop;
+	}
+
 private:
 	static Thread* thread_event_loop;
 
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "packet_batch.hpp"
+
+#include "portapack_shared_memory.hpp"
+
+#include "ch.h"
+
+namespace packet_batch {
+
+constexpr systime_t max_latency = MS2ST(10);
+
+static PacketBatchMessage batch { };
+static systime_t batch_start { 0 };
+
+void push(const Message& message, const size_t size) {
+	if( !batch.append(message, size) ) {
+		flush();
+		batch.append(message, size);
+	}
+
+	if( batch.count == 1 ) {
+		batch_start = chTimeNow();
+	}
+}
+
+void poll() {
+	if( !batch.empty() && ((chTimeNow() - batch_start) >= max_latency) ) {
+		flush();
+	}
+}
+
+void flush() {
+	if( !batch.empty() ) {
+		shared_memory.application_queue.push(batch);
+		batch.clear();
+	}
+}
+
+} /* namespace packet_batch */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PACKET_BATCH_H__
+#define __PACKET_BATCH_H__
+
+#include "message.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+/* Decoded packets are collected into a PacketBatchMessage and pushed to the
+ * application queue once the batch is full or its oldest packet has waited
+ * max_latency. A burst of frames then costs one queue write and one M0
+ * wakeup instead of one per frame. Messages that carry a whole
+ * baseband::Packet only fit once per batch, so those are pushed directly.
+ */
+
+namespace packet_batch {
+
+void push(const Message& message, const size_t size);
+
+template<typename T>
+void push(const T& message) {
+	static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+	static_assert(alignof(T) <= sizeof(uint32_t), "batched messages must be word aligned");
+	static_assert(2 * (sizeof(T) + sizeof(uint32_t)) <= PacketBatchMessage::capacity, "message too large to batch, push it directly");
+
+	push(message, sizeof(message));
+}
+
+// Called by the baseband thread after every buffer
+void poll();
+void flush();
+
+} /* namespace packet_batch */
+
+#endif/*__PACKET_BATCH_H__*/
@@ -25,7 +25,6 @@
 #include <cstdint>
 #include <cstddef>
 #include <bitset>
-#include <functional>
 
 #include "bit_pattern.hpp"
 #include "baseband_packet.hpp"
@@ -44,17 +43,36 @@ struct FixedLength {
 	const size_t length;
 };
 
-template<typename PreambleMatcher, typename UnstuffMatcher, typename EndMatcher>
-class PacketBuilder {
+/* Payload sink bound to a member function known at compile time. The call
+ * resolves statically and is inlined into PacketBuilder::execute, instead of
+ * going through a std::function per completed packet.
+ */
+template<typename T, void (T::*Handler)(const baseband::Packet&)>
+class PacketHandler {
 public:
-	using PayloadHandlerFunc = std::function<void(const baseband::Packet& packet)>;
+	constexpr PacketHandler(
+		T* const owner
+	) : owner { owner }
+	{
+	}
+
+	void operator()(const baseband::Packet& packet) const {
+		(owner->*Handler)(packet);
+	}
 
+private:
+	T* const owner;
+};
+
+template<typename PreambleMatcher, typename UnstuffMatcher, typename EndMatcher, typename PayloadHandler>
+class PacketBuilder {
+public:
 	PacketBuilder(
 		const PreambleMatcher preamble_matcher,
 		const UnstuffMatcher unstuff_matcher,
 		const EndMatcher end_matcher,
-		PayloadHandlerFunc payload_handler
-	) : payload_handler { std::move(payload_handler) },
+		const PayloadHandler payload_handler
+	) : payload_handler { payload_handler },
 		preamble(preamble_matcher),
 		unstuff(unstuff_matcher),
 		end(end_matcher)
@@ -89,13 +107,8 @@ public:
 			}
 
 			if( end(bit_history, packet.size()) ) {
-				// NOTE: This check is to avoid std::function nullptr check, which
-				// brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
-				// TODO: Make payload_handler known at compile time.
-				if( payload_handler ) {
-					packet.set_timestamp(Timestamp::now());
-					payload_handler(packet);
-				}
+				packet.set_timestamp(Timestamp::now());
+				payload_handler(packet);
 				reset_state();
 			} else {
 				if( packet_truncated() ) {
@@ -120,7 +133,7 @@ private:
 		return packet.size() >= packet.capacity();
 	}
 
-	const PayloadHandlerFunc payload_handler;
+	const PayloadHandler payload_handler;
 
 	BitHistory bit_history { };
 	PreambleMatcher preamble { };
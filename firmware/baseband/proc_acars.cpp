@@ -28,52 +28,128 @@
 
 #include "event_m4.hpp"
 
-ACARSProcessor::ACARSProcessor() {
-	decim_0.configure(taps_11k0_decim_0.taps, 33554432);
-	decim_1.configure(taps_11k0_decim_1.taps, 131072);
-	packet.clear();
+#include "cycle_profiler.hpp"
+
+#include "sine_table_int8.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+ACARSChannel::ACARSChannel() {
+	decim_1.configure(taps_acars_decim_1.taps, 131072);
+	decim_2.configure(taps_acars_decim_2.taps, 2);
 }
 
-void ACARSProcessor::execute(const buffer_c8_t& buffer) {
-	/* 2.4576MHz, 2048 samples */
+void ACARSChannel::configure(const uint8_t new_index, const int32_t offset) {
+	index = new_index;
+	lo_phase = 0;
+	// Negative frequency, brings the channel down to 0Hz
+	lo_phase_inc = static_cast<uint32_t>(-static_cast<int64_t>(offset) * (1LL << 32) / (int64_t)wideband_fs);
+}
 
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto decimator_out = decim_1_out;
+buffer_c16_t ACARSChannel::execute(
+	const buffer_c16_t& wideband,
+	const buffer_c16_t& work
+) {
+	/* 614.4kHz, 512 samples */
+	PROFILE_BEGIN(Decimate);
+	mix(wideband, work);
 
-	/* 38.4kHz, 32 samples */
-	feed_channel_stats(decimator_out);
+	const auto decim_1_out = decim_1.execute({ work.p, wideband.count, wideband.sampling_rate }, work);
+	const auto decim_2_out = decim_2.execute(decim_1_out, work);
+	PROFILE_END(Decimate);
 
-	for(size_t i=0; i<decimator_out.count; i++) {
-		if( mf.execute_once(decimator_out.p[i]) ) {
+	/* 38.4kHz, 32 samples */
+	PROFILE_BEGIN(Demod);
+	for(size_t i=0; i<decim_2_out.count; i++) {
+		if( mf.execute_once(decim_2_out.p[i]) ) {
 			clock_recovery(mf.get_output());
 		}
 	}
+	PROFILE_END(Demod);
+
+	return decim_2_out;
 }
 
-void ACARSProcessor::consume_symbol(
-	const float raw_symbol
+void ACARSChannel::mix(
+	const buffer_c16_t& src,
+	const buffer_c16_t& dst
 ) {
-	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
-	//const auto decoded_symbol = acars_decode(sliced_symbol);
+	for(size_t i=0; i<src.count; i++) {
+		const uint8_t n = lo_phase >> 24;
+		const int32_t lo_re = sine_table_i8[(n + 64) & 0xFF];
+		const int32_t lo_im = sine_table_i8[n];
+		const int32_t re = src.p[i].real();
+		const int32_t im = src.p[i].imag();
 
-	// DEBUG
-	packet.add(sliced_symbol);
-	if (packet.size() == 256) {
-		payload_handler(packet);
-		packet.clear();
+		dst.p[i] = {
+			static_cast<int16_t>((re * lo_re - im * lo_im) >> 7),
+			static_cast<int16_t>((re * lo_im + im * lo_re) >> 7)
+		};
+		lo_phase += lo_phase_inc;
 	}
+}
+
+void ACARSChannel::consume_symbol(
+	const float raw_symbol
+) {
+	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+	const auto decoded_symbol = acars_decode(sliced_symbol);
 
-	//packet_builder.execute(decoded_symbol);
+	block_decoder.execute(decoded_symbol);
+	block_decoder_flip_even.execute(decoded_symbol ^ symbol_phase);
+	block_decoder_flip_odd.execute(decoded_symbol ^ symbol_phase ^ 1);
+	symbol_phase ^= 1;
 }
 
-void ACARSProcessor::payload_handler(
+void ACARSChannel::payload_handler(
 	const baseband::Packet& packet
 ) {
-	const ACARSPacketMessage message { packet };
+	const ACARSPacketMessage message { packet, index };
 	shared_memory.application_queue.push(message);
 }
 
+ACARSProcessor::ACARSProcessor() {
+	decim_0.configure(taps_200k_decim_0.taps, 33554432);
+}
+
+void ACARSProcessor::execute(const buffer_c8_t& buffer) {
+	/* 2.4576MHz, 2048 samples */
+
+	PROFILE_BEGIN(Decimate);
+	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+	PROFILE_END(Decimate);
+
+	/* 614.4kHz, 512 samples, each channel mixes into work on its own.
+	 * Their mixers and decimators add up under Decimate, matched filters,
+	 * clock recovery and block decoders under Demod.
+	 */
+	for(size_t i=0; i<channel_count; i++) {
+		const auto channel_out = channels[i].execute(decim_0_out, work_buffer);
+		if( i == 0 ) {
+			feed_channel_stats(channel_out);
+		}
+	}
+}
+
+void ACARSProcessor::on_message(const Message* const message) {
+	if( message->id == Message::ID::ACARSConfigure ) {
+		configure(*reinterpret_cast<const ACARSConfigureMessage*>(message));
+	}
+}
+
+void ACARSProcessor::configure(const ACARSConfigureMessage& message) {
+	channel_count = 0;
+	for(size_t i=0; i<std::min(message.channel_count, channels.size()); i++) {
+		const auto offset = message.channel_offsets[i];
+		// decim_0 is 2dB down at the edges
+		if( std::abs(offset) <= ACARSConfigureMessage::max_offset ) {
+			channels[channel_count].configure(i, offset);
+			channel_count++;
+		}
+	}
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<ACARSProcessor>() };
 	event_dispatcher.run();
@@ -33,10 +33,6 @@
 
 #include <cstdint>
 
-#include "baseband_processor.hpp"
-#include "baseband_thread.hpp"
-#include "rssi_thread.hpp"
-
 #include "channel_decimator.hpp"
 #include "matched_filter.hpp"
 
@@ -44,6 +40,8 @@
 #include "symbol_coding.hpp"
 #include "packet_builder.hpp"
 #include "baseband_packet.hpp"
+#include "bit_pattern.hpp"
+#include "crc.hpp"
 
 #include "message.hpp"
 
@@ -68,8 +66,8 @@
 // 16 taps, 1 symbol, 2 cycles
 
 // ACARS:
-// IN: 2457600/8/8 = 38400
-// Offset: 2457600/4 = 614400 (614400/8/8 = 9600)
+// IN: 2457600/4 = 614400 wideband, then 614400/8/2 = 38400 per channel
+// Offset: 2457600/4 = 614400, channels within +/-200kHz of it
 // Deviation: ???
 // Symbol: 2400
 // Decimate: 8
@@ -94,12 +92,164 @@ constexpr std::array<std::complex<float>, 16> rect_taps_38k4_4k8_1t_2k4_p { {
 	{  0.0000000000e+00f, -6.2500000000e-02f }, {  4.4194173824e-02f, -4.4194173824e-02f },
 } };
 
+/* Assembles ACARS blocks from the differentially decoded bit stream.
+ * A block starts with SYN SYN SOH, then 7-bit odd parity characters up to
+ * ETX or ETB, followed by the 16-bit BCS (CRC-CCITT, sent LSB first like the
+ * characters). A parity error drops the block right away, only blocks whose
+ * BCS checks out reach the payload handler. The packet handed over starts
+ * with SOH and ends with the BCS.
+ */
+template<typename PayloadHandler>
+class ACARSBlockDecoder {
+public:
+	ACARSBlockDecoder(
+		const PayloadHandler payload_handler
+	) : payload_handler { payload_handler }
+	{
+		reset();
+	}
+
+	void execute(const uint_fast8_t bit) {
+		if( state == State::Sync ) {
+			bit_history.add(bit);
+			if( sync(bit_history, 0) ) {
+				start_block();
+			}
+			return;
+		}
+
+		packet.add(bit);
+		character |= (bit & 1) << bit_count;
+		if( ++bit_count == 8 ) {
+			consume_character(character);
+			character = 0;
+			bit_count = 0;
+		}
+	}
+
+private:
+	enum class State {
+		Sync,
+		Text,
+		BCS,
+	};
+
+	static constexpr uint8_t soh = 0x01;
+	static constexpr uint8_t etx = 0x83;		// With parity bit
+	static constexpr uint8_t etb = 0x97;
+	static constexpr size_t min_characters = 13;	// Mode up to block ID, then ETX
+	static constexpr size_t max_characters = 240;
+
+	// SYN SYN SOH, each LSB first
+	const SyncWord sync { 0b011010000110100010000000, 24, 1 };
+
+	PayloadHandler payload_handler;
+
+	BitHistory bit_history { };
+	State state { State::Sync };
+	uint8_t character { 0 };
+	size_t bit_count { 0 };
+	size_t character_count { 0 };
+	size_t bcs_count { 0 };
+	CRC<16, true, true> bcs { 0x1021, 0x0000, 0x0000 };
+	baseband::Packet packet { };
+
+	void reset() {
+		state = State::Sync;
+		bit_history = { };
+	}
+
+	void start_block() {
+		packet.clear();
+		for(size_t i=0; i<8; i++) {
+			packet.add((soh >> i) & 1);
+		}
+		bcs.reset();
+		character = 0;
+		bit_count = 0;
+		character_count = 0;
+		state = State::Text;
+	}
+
+	void consume_character(const uint8_t c) {
+		// Running the BCS through the CRC leaves a zero remainder
+		bcs.process_byte(c);
+
+		if( state == State::Text ) {
+			if( ((__builtin_popcount(c) & 1) == 0) || (++character_count > max_characters) ) {
+				reset();
+				return;
+			}
+			if( (c == etx) || (c == etb) ) {
+				state = State::BCS;
+				bcs_count = 0;
+			}
+		} else {
+			if( ++bcs_count == 2 ) {
+				if( (bcs.checksum() == 0) && (character_count >= min_characters) ) {
+					packet.set_timestamp(Timestamp::now());
+					payload_handler(packet);
+				}
+				reset();
+			}
+		}
+	}
+};
+
+/* One ACARS channel out of the wideband capture: shifted from its offset down
+ * to 0Hz, decimated from 614.4kHz to 38.4kHz, then demodulated and decoded
+ * on its own.
+ */
+class ACARSChannel {
+public:
+	ACARSChannel();
+
+	void configure(const uint8_t index, const int32_t offset);
+
+	// Returns the 38.4kHz channel samples, work is clobbered
+	buffer_c16_t execute(const buffer_c16_t& wideband, const buffer_c16_t& work);
+
+private:
+	static constexpr size_t wideband_fs = 614400;
+
+	uint8_t index { 0 };
+	uint32_t lo_phase { 0 };
+	uint32_t lo_phase_inc { 0 };
+
+	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
+	// 16 taps at 76.8kHz can't reach 40dB by 12.5kHz, this one has 48
+	dsp::decimate::FIRAndDecimateComplex decim_2 { };
+	dsp::matched_filter::MatchedFilter mf { rect_taps_38k4_4k8_1t_2k4_p, 8 };
+
+	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
+		4800, 2400, { 0.0555f },
+		[this](const float symbol) { this->consume_symbol(symbol); }
+	};
+	symbol_coding::ACARSDecoder acars_decode { };
+	uint_fast8_t symbol_phase { 0 };
+
+	void mix(const buffer_c16_t& src, const buffer_c16_t& dst);
+	void consume_symbol(const float symbol);
+	void payload_handler(const baseband::Packet& packet);
+
+	/* An inverted slicer leaves the decoded stream with every other bit
+	 * flipped, starting on either bit, so two more block decoders listen for
+	 * that. Only one of the three can get a block through the BCS.
+	 */
+	using BlockHandler = PacketHandler<ACARSChannel, &ACARSChannel::payload_handler>;
+	ACARSBlockDecoder<BlockHandler> block_decoder { { this } };
+	ACARSBlockDecoder<BlockHandler> block_decoder_flip_even { { this } };
+	ACARSBlockDecoder<BlockHandler> block_decoder_flip_odd { { this } };
+};
+
 class ACARSProcessor : public BasebandProcessor {
 public:
 	ACARSProcessor();
 
 	void execute(const buffer_c8_t& buffer) override;
 
+	void on_message(const Message* const message) override;
+
 private:
 	static constexpr size_t baseband_fs = 2457600;
 
@@ -111,28 +261,18 @@ private:
 		dst.data(),
 		dst.size()
 	};
+	std::array<complex16_t, 512> work { };
+	const buffer_c16_t work_buffer {
+		work.data(),
+		work.size()
+	};
 
-	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };	// Translate already done here !
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::matched_filter::MatchedFilter mf { rect_taps_38k4_4k8_1t_2k4_p, 8 };
+	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };	// Translate already done here !
 
-	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
-		4800, 2400, { 0.0555f },
-		[this](const float symbol) { this->consume_symbol(symbol); }
-	};
-	symbol_coding::ACARSDecoder acars_decode { };
-	/*PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder {
-		{ 0b011010000110100010000000, 24, 1 },	// SYN, SYN, SOH
-		{ },
-		{ 128 },
-		[this](const baseband::Packet& packet) {
-			this->payload_handler(packet);
-		}
-	};*/
-	baseband::Packet packet { };
+	std::array<ACARSChannel, ACARSConfigureMessage::max_channels> channels { };
+	size_t channel_count { 1 };
 
-	void consume_symbol(const float symbol);
-	void payload_handler(const baseband::Packet& packet);
+	void configure(const ACARSConfigureMessage& message);
 };
 
 #endif/*__PROC_ACARS_H__*/
@@ -24,6 +24,7 @@
 #include "portapack_shared_memory.hpp"
 #include "sine_table_int8.hpp"
 #include "event_m4.hpp"
+#include "packet_batch.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -64,7 +65,7 @@ void ADSBRXProcessor::execute(const buffer_c8_t& buffer) {
 					// Both under window, silence.
 					if (null_count > 3) {
 						const ADSBFrameMessage message(frame);
-						shared_memory.application_queue.push(message);
+						packet_batch::push(message);
 							
 						decoding = false;
 					} else
@@ -25,6 +25,8 @@
 
 #include "event_m4.hpp"
 
+#include <algorithm>
+
 void AFSKRxProcessor::execute(const buffer_c8_t& buffer) {
 	// This is called at 3072000 / 2048 = 1500Hz
 
@@ -79,31 +81,13 @@ void AFSKRxProcessor::execute(const buffer_c8_t& buffer) {
 		if (phase >= 0x10000) {
 			phase &= 0xFFFF;
 			
-			if (trigger_word) {
-				
-				// Continuous-stream value-triggered mode (AX.25) - UNTESTED
-				word_bits <<= 1;
-				word_bits |= (sample_bits & 1);
+			if (hdlc_frames) {
 				
-				bit_counter++;
-				
-				if (triggered) {
-					if (bit_counter == word_length) {
-						bit_counter = 0;
-						
-						data_message.is_data = true;
-						data_message.value = word_bits & word_mask;
-						shared_memory.application_queue.push(data_message);
-					}
-				} else {
-					if ((word_bits & word_mask) == trigger_value) {
-						triggered = !triggered;
-						bit_counter = 0;
-						
-						data_message.is_data = true;
-						data_message.value = trigger_value;
-						shared_memory.application_queue.push(data_message);
-					}
+				// AX.25 style HDLC frames, NRZI decoding and unstuffing are left to the deframer
+				if (deframer.execute(sample_bits & 1) && (deframer.size() > 2)) {
+					frame_message.size = deframer.size() - 2;
+					std::copy(deframer.data(), deframer.data() + frame_message.size, frame_message.data.begin());
+					shared_memory.application_queue.push(frame_message);
 				}
 				
 			} else {
@@ -170,15 +154,13 @@ void AFSKRxProcessor::configure(const AFSKRxConfigureMessage& message) {
 	phase_inc = (0x10000 * message.baudrate) / audio_fs;
 	phase = 0;
 	
-	trigger_word = message.trigger_word;
+	hdlc_frames = message.hdlc;
 	word_length = message.word_length;
-	trigger_value = message.trigger_value;
-	word_mask = (1 << word_length) - 1;
 	
 	// Delay line
 	delay_line_index = 0;
 	
-	triggered = false;
+	deframer = { };
 	state = WAIT_START;
 	
 	configured = true;
@@ -32,6 +32,8 @@
 
 #include "audio_output.hpp"
 
+#include "hdlc_deframer.hpp"
+
 #include "fifo.hpp"
 #include "message.hpp"
 
@@ -86,18 +88,19 @@ private:
 	uint32_t phase { }, phase_inc { };
 	int32_t sample_mixed { }, prev_mixed { }, sample_filtered { }, prev_filtered { };
 	uint32_t word_length { };
-	uint32_t word_mask { };
-	uint32_t trigger_value { };
 	
 	bool configured { false };
 	bool wait_start { };
 	bool bit_value { };
-	bool trigger_word { };
-	bool triggered { };
+	bool hdlc_frames { };
+	
+	hdlc::Deframer deframer { };
+	static_assert(hdlc::Deframer::max_size <= AFSKFrameMessage::max_size, "AFSKFrameMessage can't hold a frame");
 	
 	void configure(const AFSKRxConfigureMessage& message);
 	
 	AFSKDataMessage data_message { false, 0 };
+	AFSKFrameMessage frame_message { };
 };
 
 #endif/*__PROC_TPMS_H__*/
@@ -69,17 +69,16 @@ private:
 		[this](const float symbol) { this->consume_symbol(symbol); }
 	};
 	symbol_coding::NRZIDecoder nrzi_decode { };
-	PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder {
+
+	void consume_symbol(const float symbol);
+	void payload_handler(const baseband::Packet& packet);
+
+	PacketBuilder<SyncWord, SyncWord, SyncWord, PacketHandler<AISProcessor, &AISProcessor::payload_handler>> packet_builder {
 		{ 0b0101010101111110, 16, 1 },
 		{ 0b111110, 6 },
 		{ 0b01111110, 8 },
-		[this](const baseband::Packet& packet) {
-			this->payload_handler(packet);
-		}
+		{ this }
 	};
-
-	void consume_symbol(const float symbol);
-	void payload_handler(const baseband::Packet& packet);
 };
 
 #endif/*__PROC_AIS_H__*/
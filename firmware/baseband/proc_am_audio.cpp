@@ -24,6 +24,7 @@
 #include "audio_output.hpp"
 
 #include "event_m4.hpp"
+#include "cycle_profiler.hpp"
 
 #include <array>
 
@@ -32,33 +33,54 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 
+	PROFILE_BEGIN(Decimate);
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
 	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+	PROFILE_END(Decimate);
 
+	PROFILE_BEGIN(Spectrum);
 	if(spec_zoom == 0)
 		channel_spectrum.feed(decim_1_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+	PROFILE_END(Spectrum);
 
+	PROFILE_BEGIN(Decimate);
 	const auto decim_2_pre_out = decim_2_pre_filter.execute(decim_1_out, dst_buffer);
+	PROFILE_END(Decimate);
 
+	PROFILE_BEGIN(Spectrum);
 	if(spec_zoom == 1)
 		channel_spectrum.feed(decim_2_pre_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+	PROFILE_END(Spectrum);
 
+	PROFILE_BEGIN(Decimate);
 	const auto decim_2_out = decim_2.execute(decim_2_pre_out, dst_buffer);
+	PROFILE_END(Decimate);
 
+	PROFILE_BEGIN(Spectrum);
 	if(spec_zoom == 2)
 		channel_spectrum.feed(decim_2_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+	PROFILE_END(Spectrum);
 
+	PROFILE_BEGIN(Filter);
 	const auto channel_out = channel_filter.execute(decim_2_out, dst_buffer);
+	PROFILE_END(Filter);
 
+	PROFILE_BEGIN(Spectrum);
 	if(spec_zoom > 2)
 		channel_spectrum.feed(channel_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+	PROFILE_END(Spectrum);
 
 	// TODO: Feed channel_stats post-decimation data?
 	feed_channel_stats(channel_out);
 
+	PROFILE_BEGIN(Demod);
 	auto audio = demodulate(channel_out);
+	PROFILE_END(Demod);
+
+	PROFILE_BEGIN(Audio);
 	audio_compressor.execute_in_place(audio);
 	audio_output.write(audio);
+	PROFILE_END(Audio);
 }
 
 buffer_f32_t NarrowbandAMAudio::demodulate(const buffer_c16_t& channel) {
@@ -102,10 +124,10 @@ void NarrowbandAMAudio::configure(const AMConfigureMessage& message) {
 	constexpr size_t channel_filter_input_fs = decim_2_output_fs;
 	//const size_t channel_filter_output_fs = channel_filter_input_fs / channel_filter_decimation_factor;
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
+	decim_0.configure(taps_6k0_decim_0.taps, 33554432);
+	decim_1.configure(taps_6k0_decim_1.taps, 131072);
 	decim_2_pre_filter.configure(taps_6k0_decim_2_pre.taps, decim_2_pre_decimation_factor);
-	decim_2.configure(message.decim_2_filter.taps, decim_2_decimation_factor);
+	decim_2.configure(taps_6k0_decim_2.taps, decim_2_decimation_factor);
 	channel_filter.configure(message.channel_filter.taps, channel_filter_decimation_factor);
 	channel_filter_low_f = message.channel_filter.low_frequency_normalized * channel_filter_input_fs;
 	channel_filter_high_f = message.channel_filter.high_frequency_normalized * channel_filter_input_fs;
@@ -34,14 +34,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 	
-	std::fill(spectrum.begin(), spectrum.end(), 0);
-
-	for(size_t i=0; i<spectrum.size(); i++) {
-		spectrum[i] += buffer.p[i];
-	}
-
-	const buffer_c16_t buffer_c16 {spectrum.data(),spectrum.size(),buffer.sampling_rate};
-	channel_spectrum.feed(buffer_c16);
+	tv_collector.feed(buffer);
 
     int8_t re;
 	//int8_t im;
@@ -61,9 +54,8 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 
 void WidebandFMAudio::on_message(const Message* const message) {
 	switch(message->id) {
-	case Message::ID::UpdateSpectrum:
 	case Message::ID::SpectrumStreamingConfig:
-		channel_spectrum.on_message(message);
+		tv_collector.on_message(message);
 		break;
 
 	case Message::ID::WFMConfigure:
@@ -54,8 +54,7 @@ private:
 	};
 
 	AudioSpectrum audio_spectrum { };
-	TvCollector channel_spectrum { };
-        std::array<complex16_t, 256> spectrum { };
+	TvCollector tv_collector { };
 
 	bool configured { false };
 	void configure(const WFMConfigureMessage& message);
@@ -24,8 +24,7 @@
 #include "portapack_shared_memory.hpp"
 
 #include "event_m4.hpp"
-
-#include "stdio.h"
+#include "cycle_profiler.hpp"
 
 void APRSRxProcessor::execute(const buffer_c8_t& buffer) {
 	// This is called at 3072000 / 2048 = 1500Hz
@@ -33,183 +32,64 @@ void APRSRxProcessor::execute(const buffer_c8_t& buffer) {
 	if (!configured) return;
 	
 	// FM demodulation
+	PROFILE_BEGIN(Decimate);
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);				// 2048 / 8 = 256 (512 I/Q samples)
 	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);			// 256 / 8 = 32 (64 I/Q samples)
+	PROFILE_END(Decimate);
+
+	PROFILE_BEGIN(Filter);
 	const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);	// 32 / 2 = 16 (32 I/Q samples)
+	PROFILE_END(Filter);
 
 	feed_channel_stats(channel_out);
 	
+	PROFILE_BEGIN(Demod);
 	auto audio = demod.execute(channel_out, audio_buffer);
-	
-	audio_output.write(audio);
 
-	// Audio signal processing
 	for (size_t c = 0; c < audio.count; c++) {
-
-		const int32_t sample_int = audio.p[c] * 32768.0f;
-		int32_t current_sample = __SSAT(sample_int, 16);
-		
-		current_sample /= 128;
-		
-		// Delay line put
-		delay_line[delay_line_index & 0x3F] = current_sample;
-		
-		// Delay line get, and LPF
-		sample_mixed = (delay_line[(delay_line_index - (samples_per_bit/2)) & 0x3F] * current_sample) / 4; 
-		sample_filtered = prev_mixed + sample_mixed + (prev_filtered / 2);
-		
-		delay_line_index++;
-		
-		prev_filtered = sample_filtered;
-		prev_mixed = sample_mixed;		
-
-		// Slice
-		sample_bits <<= 1;
-
-		uint8_t bit = (sample_filtered < -20) ? 1 : 0;
-		sample_bits |= bit;
-
-/*
-		int16_t scaled = bit == 1 ? 32767 : -32767;
-
-		if( stream ) {
-			const size_t bytes_to_write = sizeof(scaled) * 1;
-			const auto result = stream->write(&scaled, bytes_to_write);
-		}
-*/
-		
-		// Check for "clean" transition: either 0011 or 1100
-		if ((((sample_bits >> 2) ^ sample_bits) & 3) == 3) {
-			// Adjust phase
-			if (phase < 0x8000)
-				phase += 0x800;		// Is this a proper value ?
-			else
-				phase -= 0x800;
-		}
-		
-		phase += phase_inc;
-		
-		if (phase >= 0x10000) {
-			phase &= 0xFFFF;
-			
-			if (true) {			
-				uint8_t bit;					
-				if(__builtin_popcount(sample_bits & 0xFF) >= 0x05){
-					bit = 0x1;
-				}
-				else {
-					bit = 0x0;
-				}
-
-				if(parse_bit(bit)){
-					parse_packet();
-				}						
-			}
+		auto frames = demod_bank.execute(audio.p[c]);
+		for (size_t n = 0; frames; n++, frames >>= 1) {
+			if (frames & 1)
+				on_frame(demod_bank.deframer(n));
 		}
+		sample_time++;
 	}
+	PROFILE_END(Demod);
+
+	PROFILE_BEGIN(Audio);
+	audio_output.write(audio);
+	PROFILE_END(Audio);
 }
 
-void APRSRxProcessor::parse_packet(){
-	//validate crc	
-	if(packet_buffer_size >= aprs::APRS_MIN_LENGTH){
-		uint16_t crc = 0xFFFF;
+void APRSRxProcessor::on_frame(const hdlc::Deframer& deframer) {
+	const auto data = deframer.data();
+	const auto size = deframer.size();
 
-		for(size_t i = 0; i < packet_buffer_size; i++){			
-			uint8_t byte = packet_buffer[i];
-			crc = ((crc >> 8) ^ crc_ccitt_tab[(crc ^ byte) & 0xFF]) & 0xFFFF;
-		}	
+	// The deframer only lets frames with a good FCS through
+	if (size < aprs::APRS_MIN_LENGTH)
+		return;
 
-		if(crc == 0xF0B8){		
-			parse_ax25();
-		}
-	}	
-}
+	if (is_duplicate(data[size - 2] | (data[size - 1] << 8), size))
+		return;
 
-void APRSRxProcessor::parse_ax25(){	
 	aprs_packet.clear();
 	aprs_packet.set_valid_checksum(true);
 
-	for(size_t i = 0; i < packet_buffer_size; i++){
-		aprs_packet.set(i, packet_buffer[i]);
-	}
+	for (size_t i = 0; i < size; i++)
+		aprs_packet.set(i, data[i]);
 
 	APRSPacketMessage packet_message { aprs_packet };
 	shared_memory.application_queue.push(packet_message);
 }
 
-bool APRSRxProcessor::parse_bit(const uint8_t current_bit){
-	uint8_t decoded_bit = ~(current_bit ^ last_bit) & 0x1;
-	last_bit = current_bit;
-
-	//int16_t log = decoded_bit == 0 ? -32768 : 32767;
-				
-	//if( stream ) {
-	//	const size_t bytes_to_write = sizeof(log) * 1;
-	//	const auto result = stream->write(&log, bytes_to_write);
-	//}
-
-	if(decoded_bit & 0x1){
-		if(ones_count < 8){
-			ones_count++;
-		}
-	}
-	else {
-		if(ones_count > 6){ //not valid
-			state = WAIT_FLAG;
-			current_byte = 0;
-			ones_count = 0;
-			byte_index = 0;
-			packet_buffer_size = 0;
-			return false;
-		}
-		else if(ones_count == 6){ //flag
-			bool done = false;
-			if(state == IN_FRAME){				
-				done = true;
-			}
-			else {
-				packet_buffer_size = 0;
-			}
-			state = WAIT_FRAME;
-			current_byte = 0;
-			ones_count = 0;
-			byte_index = 0;			
-
-			return done;
-		}
-		else if(ones_count == 5){ //bit stuff
-			ones_count = 0;
-			return false;
-		}
-		else {
-			ones_count = 0;
-		}
-	}
-
-	//store
-	current_byte = current_byte >> 1;
-	current_byte |= (decoded_bit == 0x1 ? 0x80 : 0x0);
-	byte_index++;
-
-	if(byte_index >= 8){
-		byte_index = 0;
-		if(state == WAIT_FRAME){
-			state = IN_FRAME;
-		}
-
-		if(state == IN_FRAME){	
-			if(packet_buffer_size + 1 >= 256){
-				state = WAIT_FLAG;
-				current_byte = 0;
-				ones_count = 0;
-				byte_index = 0;
-				packet_buffer_size = 0;
-				return false;
-			}
-			packet_buffer[packet_buffer_size++] = current_byte;
-		}
+bool APRSRxProcessor::is_duplicate(const uint16_t fcs, const size_t size) {
+	for (const auto& recent : recent_frames) {
+		if ((recent.fcs == fcs) && (recent.size == size) && (sample_time - recent.sample_time < duplicate_window))
+			return true;
 	}
 
+	recent_frames[recent_index] = { fcs, static_cast<uint16_t>(size), sample_time };
+	recent_index = (recent_index + 1) % recent_frames.size();
 	return false;
 }
 
@@ -238,16 +118,8 @@ void APRSRxProcessor::configure(const APRSRxConfigureMessage& message) {
 
 	audio_output.configure(audio_24k_hpf_300hz_config, audio_24k_deemph_300_6_config, 0);
 	
-	samples_per_bit = audio_fs / message.baudrate;
-	
-	phase_inc = (0x10000 * message.baudrate) / audio_fs;
-	phase = 0;
-	
-	// Delay line
-	delay_line_index = 0;
+	demod_bank.configure(audio_fs, message.baudrate);
 
-	state = WAIT_FLAG;
-	
 	configured = true;
 }
 
@@ -40,45 +40,18 @@ void AudioTXProcessor::execute(const buffer_c8_t& buffer){
 		if (resample_acc >= 0x1000000) {
 			resample_acc -= 0x1000000;
 			if (stream) {
-				if(bit_type == 0) {
-					audio_sample8 = next_audio_sample8;
-					this_sample = (int16_t)(audio_sample8 - 0x80) << 8;
-					stream->read(&next_audio_sample8, 1);
-					interp_step = ((int16_t)next_audio_sample8 - (int16_t)audio_sample8) * 256 / (int16_t)((0x1000000 - resample_acc) / resample_inc);
-					bytes_read++;
-				} else {
-					audio_sample = next_audio_sample;
-					this_sample = audio_sample;
-					stream->read(&next_audio_sample, 2);
-					interp_step = (next_audio_sample - audio_sample) / (int16_t)((0x1000000 - resample_acc) / resample_inc);
-					bytes_read += 2;
-				}
-				if(channels) {
-					if(bit_type == 0) {
-						audio_sample8_r = next_audio_sample8_r;
-						this_sample_r = (int16_t)(audio_sample8_r - 0x80) << 8;
-						stream->read(&next_audio_sample8, 1);
-						interp_step_r = ((int16_t)next_audio_sample8_r - (int16_t)audio_sample8_r) * 256 / (int16_t)((0x1000000 - resample_acc) / resample_inc);
-						bytes_read++;
-					} else {
-						audio_sample_r = next_audio_sample_r;
-						this_sample_r = audio_sample_r;
-						stream->read(&next_audio_sample_r, 2);
-						interp_step_r = (next_audio_sample_r - audio_sample_r) / (int16_t)((0x1000000 - resample_acc) / resample_inc);
-						bytes_read += 2;
-					}
-				}
+				// The M0 streams signed 16-bit mono, whatever the file format
+				audio_sample = next_audio_sample;
+				this_sample = audio_sample;
+				stream->read(&next_audio_sample, 2);
+				interp_step = (next_audio_sample - audio_sample) / (int16_t)((0x1000000 - resample_acc) / resample_inc);
+				bytes_read += 2;
 			}
 		} else {
             this_sample += interp_step;
-			this_sample_r += interp_step_r;
         }
 		
-		if(channels) {
-			sample = tone_gen.process((int8_t)((((int32_t)this_sample + (int32_t)this_sample_r) / 2) >> 8));
-		} else {
-			sample = tone_gen.process((int8_t)(this_sample >> 8));
-		}
+		sample = tone_gen.process((int8_t)(this_sample >> 8));
 		
 		if(mod_type == 1) { // AM
 			re = sample / 2 + 64;
@@ -96,20 +69,12 @@ void AudioTXProcessor::execute(const buffer_c8_t& buffer){
 		if (!as) {
 			as = audio_decimation_factor - 1;
 			audio_buffer.p[ai] = this_sample;
-			if(channels){
-				audio_buffer_right.p[ai] = this_sample_r;
-			}
 			ai++;
 		} else {
 			as--;
 		}
 		if(ai == 32) {
-			if(channels) {
-				audio_output.write_direct(audio_buffer, audio_buffer_right);
-			}
-			else {
-				audio_output.write(audio_buffer);
-			}
+			audio_output.write(audio_buffer);
 			ai = 0;
 		}
 		
@@ -158,8 +123,6 @@ void AudioTXProcessor::audio_config(const AudioTXConfigMessage& message) {
 	resample_acc = 0;
 	audio_output.configure(audio_48k_hpf_30hz_config);
 	baseband_fs = (size_t)((float)baseband_fs_base / ((float)message.speed / 100.0));
-	bit_type = message.bit_type;
-	channels = message.channels;
 	mod_type = message.mod_type;
 }
 
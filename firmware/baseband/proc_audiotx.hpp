@@ -55,21 +55,9 @@ private:
 	int8_t re { 0 }, im { 0 };
 
 	int16_t audio_sample { };
-	uint8_t audio_sample8 { };
 	int16_t next_audio_sample { 0 };
-	uint8_t next_audio_sample8 { 128 };
 	int16_t this_sample { };
 	int16_t interp_step { 0 };
-	int16_t audio_sample_r { };
-	uint8_t audio_sample8_r { };
-	int16_t next_audio_sample_r { 0 };
-	uint8_t next_audio_sample8_r { 128 };
-	int16_t this_sample_r { };
-	int16_t interp_step_r { 0 };
-
-
-	uint8_t bit_type { 0 };
-	uint8_t channels { 0 };
 	
 	size_t progress_interval_samples = 0, progress_samples = 0;
 	
@@ -88,11 +76,6 @@ private:
 		(int16_t*)audio.data(),
 		sizeof(audio) / sizeof(int16_t)
 	};
-	std::array<int16_t, 32> audio_right { };		// right channel
-	const buffer_s16_t audio_buffer_right {
-		(int16_t*)audio_right.data(),
-		sizeof(audio_right) / sizeof(int16_t)
-	};
 	uint16_t as { 0 }, ai { 0 };
 	AudioOutput audio_output { };
 };
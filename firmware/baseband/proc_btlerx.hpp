@@ -46,6 +46,11 @@ private:
 	static constexpr size_t baseband_fs = 4000000;
 	static constexpr size_t audio_fs = baseband_fs / 8 / 8 / 2;
 	
+	static constexpr uint32_t adv_access_address = 0x8E89BED6;
+	static constexpr size_t access_address_tolerance = 1;		// Bit errors
+	static constexpr size_t adv_payload_max = 37;
+	static constexpr size_t pdu_max = 2 + adv_payload_max + 3;	// Header, payload, CRC
+	
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 	
@@ -55,37 +60,37 @@ private:
 		dst.size()
 	};
 
-        std::array<complex16_t, 512> spectrum { };
-	const buffer_c16_t spectrum_buffer {
-		spectrum.data(),
-		spectrum.size()
-	};
-
 	const buffer_s16_t work_audio_buffer {
 		(int16_t*)dst.data(),
 		sizeof(dst) / sizeof(int16_t)
 	};
 
-
-	// Array size ok down to 375 bauds (24000 / 375)
-	std::array<int32_t, 64> delay_line { 0 };
-	std::array<int16_t, 1000> rb_buf { 0 };
-
-	/*dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::decimate::FIRAndDecimateComplex channel_filter { };*/
 	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
 	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
 	
 	dsp::demodulate::FM demod { };
-	int rb_head {-1};
-	int32_t g_threshold {0};  
-	uint8_t channel_number {38};
-	int skipSamples {1000};
-	int RB_SIZE {1000};
-
+	
+	enum class State {
+		AccessAddress,
+		PDU
+	};
+	
+	State state { State::AccessAddress };
+	int32_t slicer_threshold { 0 };
+	uint32_t access_address_sr { 0 };	// Last 32 sliced bits, newest in the MSB
+	
+	std::array<uint8_t, pdu_max> pdu { };
+	size_t pdu_length { 0 };			// Bytes expected, including header and CRC
+	size_t byte_count { 0 };
+	size_t bit_count { 0 };
+	uint8_t current_byte { 0 };
+	
+	size_t whitening_index { 1 };		// 0: channel 37, 1: 38, 2: 39
 	bool configured { false };
 
+	void consume_bit(const uint_fast8_t bit);
+	void consume_byte(const uint8_t byte);
+	void packet_done();
 	
 	void configure(const BTLERxConfigureMessage& message);
 	
@@ -42,6 +42,8 @@
 // ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x1f2a60)[2:].zfill(21))])
 constexpr uint64_t scm_preamble_and_sync_manchester { 0b101010101001011001100110010110100101010101 };
 constexpr size_t scm_preamble_and_sync_length { 42 - 10 };
+// Only the last 32 bits are matched, they fit a SyncWord
+constexpr uint32_t scm_sync_manchester { static_cast<uint32_t>(scm_preamble_and_sync_manchester) };
 constexpr size_t scm_payload_length_max { 150 };
 
 // ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x555516a3)[2:].zfill(32))])
@@ -71,28 +73,24 @@ private:
 		[this](const float symbol) { this->consume_symbol(symbol); }
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> scm_builder {
-		{ scm_preamble_and_sync_manchester, scm_preamble_and_sync_length, 1 },
+	void consume_symbol(const float symbol);
+	void scm_handler(const baseband::Packet& packet);
+	void idm_handler(const baseband::Packet& packet);
+
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<ERTProcessor, &ERTProcessor::scm_handler>> scm_builder {
+		{ scm_sync_manchester, scm_preamble_and_sync_length, 1 },
 		{ },
 		{ scm_payload_length_max },
-		[this](const baseband::Packet& packet) {
-			this->scm_handler(packet);
-		}
+		{ this }
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> idm_builder {
+	PacketBuilder<BitPattern, NeverMatch, FixedLength, PacketHandler<ERTProcessor, &ERTProcessor::idm_handler>> idm_builder {
 		{ idm_preamble_and_sync_manchester, idm_preamble_and_sync_length, 1 },
 		{ },
 		{ idm_payload_length_max },
-		[this](const baseband::Packet& packet) {
-			this->idm_handler(packet);
-		}
+		{ this }
 	};
 
-	void consume_symbol(const float symbol);
-	void scm_handler(const baseband::Packet& packet);
-	void idm_handler(const baseband::Packet& packet);
-
 	float sum_half_period[2];
 	float sum_period[3];
 	float manchester[3];
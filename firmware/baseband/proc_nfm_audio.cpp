@@ -25,6 +25,7 @@
 #include "portapack_shared_memory.hpp"
 
 #include "event_m4.hpp"
+#include "cycle_profiler.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -36,19 +37,30 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 	
+	PROFILE_BEGIN(Decimate);
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
 	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+	PROFILE_END(Decimate);
 
+	PROFILE_BEGIN(Spectrum);
 	channel_spectrum.feed(decim_1_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+	PROFILE_END(Spectrum);
 
+	PROFILE_BEGIN(Filter);
 	const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);
+	PROFILE_END(Filter);
 
 	feed_channel_stats(channel_out);
 
 	if (!pitch_rssi_enabled) {
 		// Normal mode, output demodulated audio
+		PROFILE_BEGIN(Demod);
 		auto audio = demod.execute(channel_out, audio_buffer);
+		PROFILE_END(Demod);
+
+		PROFILE_BEGIN(Audio);
 		audio_output.write(audio);
+		PROFILE_END(Audio);
 		
 		if (ctcss_detect_enabled) {
 			/* 24kHz int16_t[16]
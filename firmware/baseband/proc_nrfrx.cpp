@@ -26,240 +26,161 @@
 
 #include "event_m4.hpp"
 
+// CRC-16-CCITT, MSB first
+static constexpr std::array<uint16_t, 256> make_crc16_table() {
+	std::array<uint16_t, 256> table { };
+	for (uint32_t i = 0; i < 256; i++) {
+		uint16_t crc = i << 8;
+		for (size_t b = 0; b < 8; b++)
+			crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+		table[i] = crc;
+	}
+	return table;
+}
+
+static constexpr std::array<uint16_t, 256> crc16_table = make_crc16_table();
+
+void NRFRxProcessor::BitRing::add(const uint_fast8_t bit) {
+	const uint32_t word = (write_pos >> 5) & (words - 1);
+	const uint32_t offset = write_pos & 31;
+	if (offset == 0)
+		ring[word] = 0;
+	ring[word] |= (uint32_t)bit << (31 - offset);
+	write_pos++;
+	
+	window = (window << 1) | bit;
+}
+
+// Up to 32 bits starting at pos, first bit in the MSB of the result
+uint32_t NRFRxProcessor::BitRing::get_bits(const uint32_t pos, const size_t count) const {
+	const uint32_t word = (pos >> 5) & (words - 1);
+	const uint32_t offset = pos & 31;
+	const uint64_t pair = ((uint64_t)ring[word] << 32) | ring[(word + 1) & (words - 1)];
+	return (pair >> (64 - offset - count)) & ((1ULL << count) - 1);
+}
+
 void NRFRxProcessor::execute(const buffer_c8_t& buffer) {
 	if (!configured) return;
 	
 	// FM demodulation
-
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
 	feed_channel_stats(decim_0_out);
 	
 	auto audio_oversampled = demod.execute(decim_0_out, work_audio_buffer);
-	// Audio signal processing
+	
 	for (size_t c = 0; c < audio_oversampled.count; c++) {
-		int g_srate = 4; //4 for 250KPS
-		//int g_srate = 1; //1 for 1MPS, not working yet
-		int32_t current_sample = audio_oversampled.p[c]; //if I directly use this, some results can pass crc but not correct.
-                rb_head++;
-	        rb_head=(rb_head)%RB_SIZE;
-
-                rb_buf[rb_head] = current_sample;
-
-		skipSamples = skipSamples - 1;
-
-		if (skipSamples<1)
-		{
-			int32_t threshold_tmp=0;
-			for (int c=0;c<8*g_srate;c++)
-			{
-				threshold_tmp = threshold_tmp + (int32_t)rb_buf[(rb_head+c)%RB_SIZE];
-			}
+		const int32_t sample = audio_oversampled.p[c];
+		slicer_threshold += (sample - slicer_threshold) >> 6;
+		
+		// Each sample phase gets its own bit stream, the one that sees a valid packet wins
+		consume_bit(sample_phase, sample > slicer_threshold);
+		
+		if (++sample_phase == samples_per_symbol)
+			sample_phase = 0;
+		sample_count++;
+	}
+}
 
-			g_threshold = (int32_t)threshold_tmp/(8*g_srate);
+void NRFRxProcessor::consume_bit(const size_t phase, const uint_fast8_t bit) {
+	auto& ring = rings[phase];
+	ring.add(bit);
 	
-			int transitions=0;
-			if (rb_buf[(rb_head + 9*g_srate)%RB_SIZE] > g_threshold)
-			{
-				for (int c=0;c<8;c++)
-				{
-					if (rb_buf[(rb_head + c*g_srate)%RB_SIZE] > rb_buf[(rb_head + (c+1)*g_srate)%RB_SIZE])
-						transitions = transitions + 1;
-				}
-			}
-			else
-			{
-				for (int c=0;c<8;c++)
-				{
-					if (rb_buf[(rb_head + c*g_srate)%RB_SIZE] < rb_buf[(rb_head + (c+1)*g_srate)%RB_SIZE])
-						transitions = transitions + 1;
-				}
-			}
-			
-			bool packet_detected=false;
-			//if ( transitions==4 && abs(g_threshold)<15500)
-			if ( transitions==4 && abs(g_threshold)<15500)
-			{
-				int packet_length = 0;
-				uint8_t tmp_buf[10];
-				uint8_t packet_data[500];
-				uint8_t packet_packed[50];
-				uint16_t pcf;
-				uint32_t packet_crc;
-				uint32_t calced_crc;
-				uint64_t packet_addr_l;
-
-				/* extract address */
-				packet_addr_l=0;
-
-				for (int t=0;t<5;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+(1*8+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					tmp_buf[t]=byte;
-				}
-
-				for (int t=0;t<5;t++) packet_addr_l|=((uint64_t)tmp_buf[t])<<(4-t)*8;
-
-				//channel_number = 26;
-
-				
-				/* extract pcf */
-				for (int t=0;t<2;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+(6*8+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					tmp_buf[t]=byte;
-				}
-
-				pcf = tmp_buf[0]<<8 | tmp_buf[1];
-				pcf >>=7;
-
-				/* extract packet length, avoid excessive length packets */
-				if(packet_length == 0)
-					packet_length=(int)pcf>>3;
-				if (packet_length>32) 
-					packet_detected = false;
-
-				/* extract data */
-				for (int t=0;t<packet_length;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+(6*8+9+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					packet_data[t]=byte;
-				}
-
-				/* Prepare packed bit stream for CRC calculation */
-				uint64_t packet_header=packet_addr_l;
-				packet_header<<=9;
-				packet_header|=pcf;
-				for (int c=0;c<7;c++){
-					packet_packed[c]=(packet_header>>((6-c)*8))&0xFF;
-				}
-
-				for (int c=0;c<packet_length;c++){
-					packet_packed[c+7]=packet_data[c];
-				}
-
-				/* calculate packet crc */
-				const uint8_t* data = packet_packed; 
-				size_t data_len =  7+packet_length;
-				bool bit;
-				uint8_t cc;
-				uint_fast16_t crc=0x3C18;
-				while (data_len--) {
-				cc = *data++;
-				for (uint8_t i = 0x80; i > 0; i >>= 1) 
-				{
-					bit = crc & 0x8000;
-					if (cc & i) 
-					{
-						bit = !bit;
-					}
-					crc <<= 1;
-					if (bit) 
-					{
-						crc ^= 0x1021;
-					}
-				}
-					crc &= 0xffff;
-				}
-				calced_crc = (uint16_t)(crc & 0xffff);
-
-				/* extract crc */
-				for (int t=0;t<2;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+((6+packet_length)*8+9+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					tmp_buf[t]=byte;
-				}
-				packet_crc = tmp_buf[0]<<8 | tmp_buf[1];
-
-				/* NRF24L01+ packet found, dump information */
-				//if (packet_addr_l==0xE7E7E7E7)
-				if (packet_crc==calced_crc)
-				{
-					data_message.is_data = false;
-					data_message.value = 'A';
-					shared_memory.application_queue.push(data_message);
-
-					data_message.is_data = true;
-					data_message.value = packet_addr_l;
-					shared_memory.application_queue.push(data_message);
-
-					for (int c=0;c<7;c++)
-					{
-						data_message.is_data = true;
-						data_message.value = packet_addr_l >> 8;
-						shared_memory.application_queue.push(data_message);
-					}
-					/*data_message.is_data = true;
-					data_message.value = packet_addr_l;
-					shared_memory.application_queue.push(data_message);
-
-					data_message.is_data = true;
-					data_message.value = packet_addr_l >> 8;
-					shared_memory.application_queue.push(data_message);*/
-
-					data_message.is_data = false;
-					data_message.value = 'B';
-					shared_memory.application_queue.push(data_message);
-
-					for (int c=0;c<packet_length;c++)
-					{
-						data_message.is_data = true;
-						data_message.value = packet_data[c];
-						shared_memory.application_queue.push(data_message);
-					}
-
-					data_message.is_data = false;
-					data_message.value = 'C';
-					shared_memory.application_queue.push(data_message);
-
-
-					packet_detected = true;
-				}
-				else
-					packet_detected = false;
-			}
-
-			if (packet_detected) 
-			{
-				skipSamples=20;
+	// Sliding window: 8 bit preamble followed by a 40 bit address. The last
+	// preamble bit always differs from the first address bit.
+	const uint32_t preamble = (ring.window >> address_bits) & 0xFF;
+	const uint32_t address_first_byte = (ring.window >> (address_bits - 8)) & 0xFF;
+	const bool preamble_match = ((preamble == 0xAA) && (address_first_byte & 0x80)) ||
+								((preamble == 0x55) && !(address_first_byte & 0x80));
+	
+	// Addresses continuing the preamble are indistinguishable from noise or a longer preamble
+	if (preamble_match && (address_first_byte != 0xAA) && (address_first_byte != 0x55) &&
+		((int32_t)(sample_count - blank_until) >= 0)) {
+		for (auto& candidate : candidates) {
+			if (!candidate.active) {
+				candidate.active = true;
+				candidate.phase = phase;
+				candidate.start_pos = ring.write_pos - address_bits;
+				candidate.start_sample = sample_count;
+				break;
 			}
 		}
 	}
+	
+	for (auto& candidate : candidates) {
+		if (candidate.active && (candidate.phase == phase)) {
+			if (check_candidate(candidate))
+				break;
+		}
+	}
+}
+
+// Returns true if a packet was found
+bool NRFRxProcessor::check_candidate(Candidate& candidate) {
+	const auto& ring = rings[candidate.phase];
+	const uint32_t available = ring.write_pos - candidate.start_pos;
+	
+	if (available < address_bits + pcf_bits)
+		return false;
+	
+	const size_t payload_length = ring.get_bits(candidate.start_pos + address_bits, 6);
+	if (payload_length > payload_max) {
+		candidate.active = false;
+		return false;
+	}
+	
+	const size_t packet_bits = address_bits + pcf_bits + (payload_length * 8) + crc_bits;
+	if (available < packet_bits)
+		return false;
+	
+	candidate.active = false;
+	
+	// Address + PCF + payload is 1 + 8n bits long: one bit by hand, then whole bytes
+	uint16_t crc = 0xFFFF;
+	const uint32_t first_bit = ring.get_bits(candidate.start_pos, 1);
+	crc = (((crc >> 15) ^ first_bit) & 1) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+	
+	const size_t crc_bytes = ((address_bits + pcf_bits) / 8) + payload_length;
+	for (size_t i = 0; i < crc_bytes; i++) {
+		const uint8_t byte = ring.get_bits(candidate.start_pos + 1 + i * 8, 8);
+		crc = (crc << 8) ^ crc16_table[((crc >> 8) ^ byte) & 0xFF];
+	}
+	
+	const uint32_t packet_crc = ring.get_bits(candidate.start_pos + packet_bits - crc_bits, crc_bits);
+	if (crc != packet_crc)
+		return false;
+	
+	// Ignore the other phases' view of the same packet
+	blank_until = candidate.start_sample + (packet_bits - address_bits) * samples_per_symbol;
+	for (auto& other : candidates) {
+		if ((int32_t)(other.start_sample - blank_until) < 0)
+			other.active = false;
+	}
+	
+	data_message.is_data = false;
+	data_message.value = 'A';
+	shared_memory.application_queue.push(data_message);
+	
+	for (size_t i = 0; i < address_bits / 8; i++) {
+		data_message.is_data = true;
+		data_message.value = ring.get_bits(candidate.start_pos + i * 8, 8);
+		shared_memory.application_queue.push(data_message);
+	}
+	
+	data_message.is_data = false;
+	data_message.value = 'B';
+	shared_memory.application_queue.push(data_message);
+	
+	for (size_t i = 0; i < payload_length; i++) {
+		data_message.is_data = true;
+		data_message.value = ring.get_bits(candidate.start_pos + address_bits + pcf_bits + i * 8, 8);
+		shared_memory.application_queue.push(data_message);
+	}
+	
+	data_message.is_data = false;
+	data_message.value = 'C';
+	shared_memory.application_queue.push(data_message);
+	
+	return true;
 }
 
 void NRFRxProcessor::on_message(const Message* const message) {
@@ -268,10 +189,26 @@ void NRFRxProcessor::on_message(const Message* const message) {
 }
 
 void NRFRxProcessor::configure(const NRFRxConfigureMessage& message) {	
-	(void)message; //avoir unused warning
+	// Decimation by 4 leaves 1 sample per symbol at 1M and 2M, 4 at 250k
+	if (message.baudrate == 2000000) {
+		baseband_fs = 8000000;
+		samples_per_symbol = 1;
+	} else if (message.baudrate == 1000000) {
+		baseband_fs = 4000000;
+		samples_per_symbol = 1;
+	} else {
+		baseband_fs = 4000000;
+		samples_per_symbol = 4;
+	}
+	baseband_thread.set_sampling_rate(baseband_fs);
+	
 	decim_0.configure(taps_200k_wfm_decim_0.taps, 33554432);
 	decim_1.configure(taps_200k_wfm_decim_1.taps, 131072);
 	demod.configure(audio_fs, 5000);
+	
+	for (auto& candidate : candidates)
+		candidate.active = false;
+	sample_phase = 0;
 
 	configured = true;
 }
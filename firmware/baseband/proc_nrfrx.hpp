@@ -43,8 +43,38 @@ public:
 	void on_message(const Message* const message) override;
 	
 private:
-	static constexpr size_t baseband_fs = 4000000;
-	static constexpr size_t audio_fs = baseband_fs / 8 / 8 / 2;
+	static constexpr size_t audio_fs = 4000000 / 8 / 8 / 2;
+	
+	static constexpr size_t address_bits = 40;
+	static constexpr size_t pcf_bits = 9;
+	static constexpr size_t crc_bits = 16;
+	static constexpr size_t payload_max = 32;
+	
+	static constexpr size_t max_samples_per_symbol = 4;
+	static constexpr size_t max_candidates = 8;
+	
+	// Sliced bits of one symbol phase, MSB first, 512 bits deep (longest packet is 321)
+	struct BitRing {
+		static constexpr size_t words = 16;
+		static constexpr uint32_t bit_mask = (words * 32) - 1;
+		
+		std::array<uint32_t, words> ring { };
+		uint32_t write_pos { 0 };
+		uint64_t window { 0 };		// Last 64 bits, newest in the LSB
+		
+		void add(const uint_fast8_t bit);
+		uint32_t get_bits(const uint32_t pos, const size_t count) const;
+	};
+	
+	// Preamble + address match waiting for enough bits to check the CRC
+	struct Candidate {
+		bool active { false };
+		uint8_t phase { 0 };
+		uint32_t start_pos { 0 };	// First address bit
+		uint32_t start_sample { 0 };
+	};
+	
+	size_t baseband_fs { 4000000 };
 	
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
@@ -55,38 +85,29 @@ private:
 		dst.size()
 	};
 
-        std::array<complex16_t, 512> spectrum { };
-	const buffer_c16_t spectrum_buffer {
-		spectrum.data(),
-		spectrum.size()
-	};
-
 	const buffer_s16_t work_audio_buffer {
 		(int16_t*)dst.data(),
 		sizeof(dst) / sizeof(int16_t)
 	};
 
-
-	// Array size ok down to 375 bauds (24000 / 375)
-	std::array<int32_t, 64> delay_line { 0 };
-	std::array<int16_t, 1000> rb_buf { 0 };
-
-	/*dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::decimate::FIRAndDecimateComplex channel_filter { };*/
 	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
 	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
 	
 	dsp::demodulate::FM demod { };
-	int rb_head {-1};
-	int32_t g_threshold {0};  
-	//uint8_t g_srate {8}; 
-	uint8_t channel_number {38};
-	int skipSamples {1000};
-	int RB_SIZE {1000};
+	
+	size_t samples_per_symbol { 4 };
+	size_t sample_phase { 0 };
+	uint32_t sample_count { 0 };
+	uint32_t blank_until { 0 };		// Sample index where the last good packet ended
+	int32_t slicer_threshold { 0 };
+	
+	std::array<BitRing, max_samples_per_symbol> rings { };
+	std::array<Candidate, max_candidates> candidates { };
 
 	bool configured { false };
-
+	
+	void consume_bit(const size_t phase, const uint_fast8_t bit);
+	bool check_candidate(Candidate& candidate);
 	
 	void configure(const NRFRxConfigureMessage& message);
 	
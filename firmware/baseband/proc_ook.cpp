@@ -26,93 +26,148 @@
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 void OOKProcessor::execute(const buffer_c8_t& buffer) {
-	int8_t re, im;
-	
 	// This is called at 2.28M/2048 = 1113Hz
 	
-	if (!configured) return;
+	if (!configured) {
+		// Keep draining a finished stream so the M0 thread isn't left waiting
+		// for an empty buffer when it's told to stop
+		if (stream && stream_ready) {
+			stream->read(buffer.p, buffer.count * sizeof(*buffer.p));
+			std::fill(buffer.p, buffer.p + buffer.count, symbol_iq[0]);
+		}
+		return;
+	}
 	
-	for (size_t i = 0; i < buffer.count; i++) {
-		
-		// Synthesis at 2.28M/10 = 228kHz
-		if (!s) {
-			s = 10 - 1;
-			if (sample_count >= samples_per_bit) {
-				if (configured) {
-					if (bit_pos >= length) {
-						// End of data
-						if (pause_counter == 0) {
-							pause_counter = pause;
-							cur_bit = 0;
-						} else if (pause_counter == 1) {
-							if (repeat_counter < repeat) {
-								// Repeat
-								bit_pos = 0;
-								cur_bit = shared_memory.bb_data.data[0] & 0x80;
-								txprogress_message.progress = repeat_counter + 1;
-								txprogress_message.done = false;
-								shared_memory.application_queue.push(txprogress_message);
-								repeat_counter++;
-							} else {
-								// Stop
-								cur_bit = 0;
-								txprogress_message.done = true;
-								shared_memory.application_queue.push(txprogress_message);
-								configured = false;
-							}
-							pause_counter = 0;
-						} else {
-							pause_counter--;
-						}
-					} else {
-						cur_bit = (shared_memory.bb_data.data[bit_pos >> 3] << (bit_pos & 7)) & 0x80;
-						bit_pos++;
-					}
-				}
-				
-				sample_count = 0;
-			} else {
-				sample_count++;
+	// Streamed data: wait until the M0 has prefilled the buffers
+	if (streamed && !stream_ready) return;
+	
+	// Symbols are written as runs of their precomputed sample, so the cost is
+	// per symbol rather than per sample
+	size_t i = 0;
+	while (i < buffer.count) {
+		if (!symbol_samples_left) {
+			if (!configured) {
+				std::fill(&buffer.p[i], &buffer.p[buffer.count], symbol_iq[0]);
+				break;
 			}
-		} else {
-			s--;
+			next_symbol();
+			symbol_samples_left = samples_per_bit;
 		}
 		
-		if (cur_bit) {
-			phase = (phase + 200);			// What ?
-			sphase = phase + (64 << 18);
+		const size_t run = std::min<size_t>(symbol_samples_left, buffer.count - i);
+		std::fill(&buffer.p[i], &buffer.p[i + run], symbol_iq[cur_bit ? 1 : 0]);
+		i += run;
+		symbol_samples_left -= run;
+	}
+}
 
-			re = (sine_table_i8[(sphase & 0x03FC0000) >> 18]);
-			im = (sine_table_i8[(phase & 0x03FC0000) >> 18]);
+void OOKProcessor::next_symbol() {
+	if (bit_pos < length) {
+		if (fetch_bit(cur_bit)) {
+			bit_pos++;
 		} else {
-			re = 0;
-			im = 0;
+			// Stream underrun, hold the bit position and send a gap
+			cur_bit = 0;
 		}
+		return;
+	}
 	
-		buffer.p[i] = {re, im};
+	// End of data
+	cur_bit = 0;
+	if (pause_counter == 0) {
+		pause_counter = pause;
+	} else if (pause_counter == 1) {
+		if (repeat_counter < repeat) {
+			// Repeat, the last pause symbol carries the first bit
+			bit_pos = 0;
+			next_symbol();
+			txprogress_message.progress = repeat_counter + 1;
+			txprogress_message.done = false;
+			shared_memory.application_queue.push(txprogress_message);
+			repeat_counter++;
+		} else {
+			// Stop
+			txprogress_message.done = true;
+			shared_memory.application_queue.push(txprogress_message);
+			configured = false;
+		}
+		pause_counter = 0;
+	} else {
+		pause_counter--;
 	}
 }
 
-void OOKProcessor::on_message(const Message* const p) {
-	const auto message = *reinterpret_cast<const OOKConfigureMessage*>(p);
+bool OOKProcessor::fetch_bit(uint8_t& bit) {
+	if (!streamed) {
+		bit = (shared_memory.bb_data.data[bit_pos >> 3] << (bit_pos & 7)) & 0x80;
+		return true;
+	}
+	
+	// Repeats follow each other back to back in the stream, bit_pos isn't used
+	if (!stream_bits) {
+		if (!stream || (stream->read(&stream_byte, 1) != 1))
+			return false;
+		stream_bits = 8;
+	}
 	
-	if (message.id == Message::ID::OOKConfigure) {
-		samples_per_bit = message.samples_per_bit / 10;
-		repeat = message.repeat - 1;
-		length = message.stream_length;
-		pause = message.pause_symbols + 1;
+	bit = stream_byte & 0x80;
+	stream_byte <<= 1;
+	stream_bits--;
+	return true;
+}
+
+void OOKProcessor::on_message(const Message* const p) {
+	switch(p->id) {
+		case Message::ID::OOKConfigure:
+			configure(*reinterpret_cast<const OOKConfigureMessage*>(p));
+			break;
+		
+		case Message::ID::ReplayConfig:
+			replay_config(*reinterpret_cast<const ReplayConfigMessage*>(p));
+			break;
+		
+		// App has prefilled the buffers, we're ready to go now
+		case Message::ID::FIFOData:
+			stream_ready = true;
+			break;
+		
+		default:
+			break;
+	}
+}
+
+void OOKProcessor::configure(const OOKConfigureMessage& message) {
+	samples_per_bit = std::max<uint32_t>(message.samples_per_bit, 1);
+	repeat = message.repeat - 1;
+	length = message.stream_length;
+	pause = message.pause_symbols + 1;
+	streamed = message.streamed;
+
+	pause_counter = 0;
+	symbol_samples_left = 0;
+	repeat_counter = 0;
+	bit_pos = 0;
+	cur_bit = 0;
+	stream_bits = 0;
+	txprogress_message.progress = 0;
+	txprogress_message.done = false;
+	configured = true;
+}
+
+void OOKProcessor::replay_config(const ReplayConfigMessage& message) {
+	stream_ready = false;
+	stream_bits = 0;
 	
-		pause_counter = 0;
-		s = 0;
-		sample_count = samples_per_bit;
-		repeat_counter = 0;
-		bit_pos = 0;
-		cur_bit = 0;
-		txprogress_message.progress = 0;
-		txprogress_message.done = false;
-		configured = true;
+	if (message.config) {
+		stream = std::make_unique<StreamOutput>(message.config);
+		
+		// Tell application that the buffers and FIFO pointers are ready, prefill
+		shared_memory.application_queue.push(sig_message);
+	} else {
+		stream.reset();
 	}
 }
 
@@ -25,6 +25,11 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "stream_output.hpp"
+#include "sine_table_int8.hpp"
+
+#include <array>
+#include <memory>
 
 class OOKProcessor : public BasebandProcessor {
 public:
@@ -34,6 +39,8 @@ public:
 
 private:
 	bool configured = false;
+	bool streamed = false;
+	bool stream_ready = false;
 	
 	BasebandThread baseband_thread { 2280000, this, NORMALPRIO + 20, baseband::Direction::Transmit };
 	
@@ -44,14 +51,27 @@ private:
 	
 	uint32_t pause_counter { 0 };
 	uint8_t repeat_counter { 0 };
-	uint8_t s { 0 };
-    uint16_t bit_pos { 0 };
-    uint8_t cur_bit { 0 };
-    uint32_t sample_count { 0 };
-	uint32_t tone_phase { 0 }, phase { 0 }, sphase { 0 };
-	int32_t tone_sample { 0 }, sig { 0 }, frq { 0 };
+	uint32_t bit_pos { 0 };
+	uint8_t cur_bit { 0 };
+	uint32_t symbol_samples_left { 0 };
+	
+	// Output sample for a 0 (off) and 1 (carrier) symbol
+	const std::array<complex8_t, 2> symbol_iq { {
+		{ 0, 0 },
+		{ sine_table_i8[64], sine_table_i8[0] }
+	} };
+	
+	std::unique_ptr<StreamOutput> stream { };
+	uint8_t stream_byte { 0 };
+	uint8_t stream_bits { 0 };
 	
 	TXProgressMessage txprogress_message { };
+	RequestSignalMessage sig_message { RequestSignalMessage::Signal::FillRequest };
+	
+	bool fetch_bit(uint8_t& bit);
+	void next_symbol();
+	void configure(const OOKConfigureMessage& message);
+	void replay_config(const ReplayConfigMessage& message);
 };
 
 #endif
@@ -25,10 +25,121 @@
 #include "proc_pocsag.hpp"
 
 #include "event_m4.hpp"
+#include "packet_batch.hpp"
 
 #include <cstdint>
 #include <cstddef>
 
+void POCSAGDecoder::configure(const pocsag::BitRate new_bitrate) {
+	bitrate_ = new_bitrate;
+	sphase_delta = 0x10000u * bitrate_ / POCSAG_AUDIO_RATE;
+	sphase_delta_half = sphase_delta / 2;			// Just for speed
+	sphase_delta_eighth = sphase_delta / 8;
+	
+	reset();
+}
+
+void POCSAGDecoder::reset() {
+	sphase = 0;
+	rx_data = 0;
+	rx_state = WAITING;
+}
+
+void POCSAGDecoder::execute(const uint32_t slicer_sr) {
+	// Detect transitions to adjust clock
+	if ((slicer_sr ^ (slicer_sr >> 1)) & 1) {
+		if (sphase < (0x8000u - sphase_delta_half))
+			sphase += sphase_delta_eighth;
+		else
+			sphase -= sphase_delta_eighth;
+	}
+	
+	sphase += sphase_delta;
+	
+	// Symbol time elapsed
+	if (sphase < 0x10000u)
+		return;
+	
+	sphase &= 0xFFFFu;
+	
+	rx_data <<= 1;
+	rx_data |= (slicer_sr & 1);
+	
+	switch (rx_state) {
+		
+		case WAITING:
+			if (rx_data == 0xAAAAAAAA) {
+				rx_state = PREAMBLE;
+				sync_timeout = 0;
+			}
+			break;
+		
+		case PREAMBLE:
+			if (sync_timeout < POCSAG_TIMEOUT) {
+				sync_timeout++;
+
+				if (rx_data == POCSAG_SYNCWORD) {
+					packet.clear();
+					codeword_count = 0;
+					rx_bit = 0;
+					msg_timeout = 0;
+					rx_state = SYNC;
+				}
+				
+			} else {
+				// Timeout here is normal (end of message)
+				rx_state = WAITING;
+				//push_packet(pocsag::PacketFlag::TIMED_OUT);
+			}
+			break;
+		
+		case SYNC:
+			if (msg_timeout < POCSAG_BATCH_LENGTH) {
+				msg_timeout++;
+				rx_bit++;
+				
+				if (rx_bit >= 32) {
+					rx_bit = 0;
+					
+					// Got a complete codeword
+					uint32_t codeword = rx_data;
+					const auto result = pocsag::bch::correct(codeword);
+					if (result == pocsag::bch::Result::Corrected)
+						packet.set_corrected(codeword_count);
+					else if (result == pocsag::bch::Result::Failed)
+						packet.set_failed(codeword_count);
+					
+					packet.set(codeword_count, codeword);
+					
+					if (codeword_count < 15) {
+						codeword_count++;
+					} else {
+						push_packet(pocsag::PacketFlag::NORMAL);
+						rx_state = PREAMBLE;
+						sync_timeout = 0;
+					}
+				}
+			} else {
+				packet.set(0, codeword_count);	// Replace first codeword with count, for debug
+				push_packet(pocsag::PacketFlag::TIMED_OUT);
+				rx_state = WAITING;
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+void POCSAGDecoder::push_packet(pocsag::PacketFlag flag) {
+	// The bitrate tells the application which chain locked
+	packet.set_bitrate(bitrate_);
+	packet.set_flag(flag);
+	packet.set_timestamp(Timestamp::now());
+	const POCSAGPacketMessage message(packet);
+	packet_batch::push(message);
+}
+
 void POCSAGProcessor::execute(const buffer_c8_t& buffer) {
 	// This is called at 1500Hz
 	
@@ -51,96 +162,13 @@ void POCSAGProcessor::execute(const buffer_c8_t& buffer) {
 			slicer_sr |= (audio_sample < 0);		// Do we need hysteresis ?
 		else
 			slicer_sr |= !(audio_sample < 0);
-			
-		// Detect transitions to adjust clock
-		if ((slicer_sr ^ (slicer_sr >> 1)) & 1) {
-			if (sphase < (0x8000u - sphase_delta_half))
-				sphase += sphase_delta_eighth;
-			else
-				sphase -= sphase_delta_eighth;
-		}
-		
-		sphase += sphase_delta;
 		
-		// Symbol time elapsed
-		if (sphase >= 0x10000u) {
-			sphase &= 0xFFFFu;
-			
-			rx_data <<= 1;
-			rx_data |= (slicer_sr & 1);
-			
-			switch (rx_state) {
-				
-				case WAITING:
-					if (rx_data == 0xAAAAAAAA) {
-						rx_state = PREAMBLE;
-						sync_timeout = 0;
-					}
-					break;
-				
-				case PREAMBLE:
-					if (sync_timeout < POCSAG_TIMEOUT) {
-						sync_timeout++;
-
-						if (rx_data == POCSAG_SYNCWORD) {
-							packet.clear();
-							codeword_count = 0;
-							rx_bit = 0;
-							msg_timeout = 0;
-							rx_state = SYNC;
-						}
-						
-					} else {
-						// Timeout here is normal (end of message)
-						rx_state = WAITING;
-						//push_packet(pocsag::PacketFlag::TIMED_OUT);
-					}
-					break;
-				
-				case SYNC:
-					if (msg_timeout < POCSAG_BATCH_LENGTH) {
-						msg_timeout++;
-						rx_bit++;
-						
-						if (rx_bit >= 32) {
-							rx_bit = 0;
-							
-							// Got a complete codeword
-							
-							//pocsag_brute_repair(&s->l2.pocsag, &rx_data);
-							
-							packet.set(codeword_count, rx_data);
-							
-							if (codeword_count < 15) {
-								codeword_count++;
-							} else {
-								push_packet(pocsag::PacketFlag::NORMAL);
-								rx_state = PREAMBLE;
-								sync_timeout = 0;
-							}
-						}
-					} else {
-						packet.set(0, codeword_count);	// Replace first codeword with count, for debug
-						push_packet(pocsag::PacketFlag::TIMED_OUT);
-						rx_state = WAITING;
-					}
-					break;
-
-				default:
-					break;
-			}
-		}
+		// Slicing is shared, each chain only does its own symbol timing
+		for (size_t d = 0; d < decoder_count; d++)
+			decoders[d].execute(slicer_sr);
 	}
 }
 
-void POCSAGProcessor::push_packet(pocsag::PacketFlag flag) {
-	packet.set_bitrate(bitrate);
-	packet.set_flag(flag);
-	packet.set_timestamp(Timestamp::now());
-	const POCSAGPacketMessage message(packet);
-	shared_memory.application_queue.push(message);
-}
-
 void POCSAGProcessor::on_message(const Message* const message) {
 	if (message->id == Message::ID::POCSAGConfigure)
 		configure(*reinterpret_cast<const POCSAGConfigureMessage*>(message));
@@ -164,13 +192,18 @@ void POCSAGProcessor::configure(const POCSAGConfigureMessage& message) {
 	demod.configure(demod_input_fs, 4500);
 	//audio_output.configure(false);
 
-	bitrate = message.bitrate;
 	phase = message.phase;
-	sphase_delta = 0x10000u * bitrate / POCSAG_AUDIO_RATE;
-	sphase_delta_half = sphase_delta / 2;			// Just for speed
-	sphase_delta_eighth = sphase_delta / 8;
 	
-	rx_state = WAITING;
+	if (message.bitrate == pocsag::BitRate::AUTO) {
+		decoders[0].configure(pocsag::BitRate::FSK512);
+		decoders[1].configure(pocsag::BitRate::FSK1200);
+		decoders[2].configure(pocsag::BitRate::FSK2400);
+		decoder_count = 3;
+	} else {
+		decoders[0].configure(message.bitrate);
+		decoder_count = 1;
+	}
+	
 	configured = true;
 }
 
@@ -35,17 +35,23 @@
 #include "pocsag_packet.hpp"
 
 #include "pocsag.hpp"
+#include "pocsag_bch.hpp"
 #include "message.hpp"
 #include "audio_output.hpp"
 #include "portapack_shared_memory.hpp"
 
 #include <cstdint>
 
-class POCSAGProcessor : public BasebandProcessor {
+// One symbol timing recovery + batch framing chain, for a single bitrate
+class POCSAGDecoder {
 public:
-	void execute(const buffer_c8_t& buffer) override;
-	
-	void on_message(const Message* const message) override;
+	void configure(const pocsag::BitRate new_bitrate);
+	void reset();
+	void execute(const uint32_t slicer_sr);
+
+	pocsag::BitRate bitrate() const {
+		return bitrate_;
+	}
 
 private:
 	enum rx_states {
@@ -59,6 +65,30 @@ private:
 		//END_OF_MESSAGE = 69
 	};
 
+	uint32_t sync_timeout { 0 };
+	uint32_t msg_timeout { 0 };
+
+	uint32_t sphase { 0 };
+	uint32_t sphase_delta { 0 };
+	uint32_t sphase_delta_half { 0 };
+	uint32_t sphase_delta_eighth { 0 };
+	uint32_t rx_data { 0 };
+	uint32_t rx_bit { 0 };
+	rx_states rx_state { WAITING };
+	pocsag::BitRate bitrate_ { pocsag::BitRate::FSK1200 };
+	uint32_t codeword_count { 0 };
+	pocsag::POCSAGPacket packet { };
+
+	void push_packet(pocsag::PacketFlag flag);
+};
+
+class POCSAGProcessor : public BasebandProcessor {
+public:
+	void execute(const buffer_c8_t& buffer) override;
+	
+	void on_message(const Message* const message) override;
+
+private:
 	static constexpr size_t baseband_fs = 3072000;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
@@ -82,24 +112,15 @@ private:
 	
 	//AudioOutput audio_output { };
 
-	uint32_t sync_timeout { 0 };
-	uint32_t msg_timeout { 0 };
+	// Auto mode runs one chain per common bitrate on the same sliced audio
+	static constexpr size_t max_decoders = 3;
+	std::array<POCSAGDecoder, max_decoders> decoders { };
+	size_t decoder_count { 0 };
 
 	uint32_t slicer_sr { 0 };
-	uint32_t sphase { 0 };
-	uint32_t sphase_delta { 0 };
-	uint32_t sphase_delta_half { 0 };
-	uint32_t sphase_delta_eighth { 0 };
-	uint32_t rx_data { 0 };
-	uint32_t rx_bit { 0 };
 	bool configured = false;
-	rx_states rx_state { WAITING };
-	pocsag::BitRate bitrate { pocsag::BitRate::FSK1200 };
 	bool phase = false;
-	uint32_t codeword_count { 0 };
-	pocsag::POCSAGPacket packet { };
 	
-	void push_packet(pocsag::PacketFlag flag);
 	void configure(const POCSAGConfigureMessage& message);
 	
 };
@@ -105,6 +105,16 @@ void SondeProcessor::on_message(const Message* const msg) {
 	}
 }
 
+void SondeProcessor::meteomodem_handler(const baseband::Packet& packet) {
+	const SondePacketMessage message { sonde::Packet::Type::Meteomodem_unknown, packet };
+	shared_memory.application_queue.push(message);
+}
+
+void SondeProcessor::vaisala_handler(const baseband::Packet& packet) {
+	const SondePacketMessage message { sonde::Packet::Type::Vaisala_RS41_SG, packet };
+	shared_memory.application_queue.push(message);
+}
+
 void SondeProcessor::play_beep() {
 	beep_play = true;
 	silence_play = false;
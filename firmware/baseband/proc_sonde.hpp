@@ -154,14 +154,12 @@ private:
 			this->packet_builder_fsk_9600_Meteomodem.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_Meteomodem {
+	void meteomodem_handler(const baseband::Packet& packet);
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<SondeProcessor, &SondeProcessor::meteomodem_handler>> packet_builder_fsk_9600_Meteomodem {
 		{ 0b00110011001100110101100110110011, 32, 1 },
 		{ },
 		{ 88 * 2 * 8 },
-		[this](const baseband::Packet& packet) {
-			const SondePacketMessage message { sonde::Packet::Type::Meteomodem_unknown, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 	
 	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_4800 {
@@ -171,15 +169,13 @@ private:
 			this->packet_builder_fsk_4800_Vaisala.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_4800_Vaisala {
+	void vaisala_handler(const baseband::Packet& packet);
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<SondeProcessor, &SondeProcessor::vaisala_handler>> packet_builder_fsk_4800_Vaisala {
 		{ 0b00001000011011010101001110001000, 32, 1 }, //euquiq Header detects 4 of 8 bytes 0x10B6CA11 /this is in raw format) (these bits are not passed at the beginning of packet)
-		//{ 0b0000100001101101010100111000100001000100011010010100100000011111, 64, 1 }, //euquiq whole header detection would be 8 bytes.
+		//{ 0b0000100001101101010100111000100001000100011010010100100000011111, 64, 1 }, //euquiq whole header detection would be 8 bytes. (needs BitPattern)
 		{ },
 		{ 320 * 8 },
-		[this](const baseband::Packet& packet) {
-			const SondePacketMessage message { sonde::Packet::Type::Vaisala_RS41_SG, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 
 	void play_beep();
@@ -72,14 +72,12 @@ private:
 			this->packet_builder_fsk_9600_CC1101.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_CC1101 {
+	void payload_handler(const baseband::Packet& packet);
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<TestProcessor, &TestProcessor::payload_handler>> packet_builder_fsk_9600_CC1101 {
 		{ 0b01010110010110100101101001101010, 32, 1 },	// Manchester 0x1337
 		{ },
 		{ 22 * 8 },
-		[this](const baseband::Packet& packet) {
-			const TestAppPacketMessage message { packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 };
 
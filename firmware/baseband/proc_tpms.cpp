@@ -58,6 +58,21 @@ void TPMSProcessor::execute(const buffer_c8_t& buffer) {
 	}
 }
 
+void TPMSProcessor::fsk_19k2_schrader_handler(const baseband::Packet& packet) {
+	const TPMSPacketMessage message { tpms::SignalType::FSK_19k2_Schrader, packet };
+	shared_memory.application_queue.push(message);
+}
+
+void TPMSProcessor::ook_8k192_schrader_handler(const baseband::Packet& packet) {
+	const TPMSPacketMessage message { tpms::SignalType::OOK_8k192_Schrader, packet };
+	shared_memory.application_queue.push(message);
+}
+
+void TPMSProcessor::ook_8k4_schrader_handler(const baseband::Packet& packet) {
+	const TPMSPacketMessage message { tpms::SignalType::OOK_8k4_Schrader, packet };
+	shared_memory.application_queue.push(message);
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<TPMSProcessor>() };
 	event_dispatcher.run();
@@ -87,14 +87,12 @@ private:
 			this->packet_builder_fsk_19k2_schrader.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_19k2_schrader {
+	void fsk_19k2_schrader_handler(const baseband::Packet& packet);
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<TPMSProcessor, &TPMSProcessor::fsk_19k2_schrader_handler>> packet_builder_fsk_19k2_schrader {
 		{ 0b010101010101010101010101010110, 30, 1 },
 		{ },
 		{ 160 },
-		[this](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::FSK_19k2_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 
 	static constexpr float channel_rate_in = 307200.0f;
@@ -107,7 +105,8 @@ private:
 		channel_sample_rate / 8192.0f
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_ook_8k192_schrader {
+	void ook_8k192_schrader_handler(const baseband::Packet& packet);
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<TPMSProcessor, &TPMSProcessor::ook_8k192_schrader_handler>> packet_builder_ook_8k192_schrader {
 		/* Preamble: 11*2, 01*14, 11, 10
 		 * Payload: 37 Manchester-encoded bits
 		 * Bit rate: 4096 Hz
@@ -115,17 +114,15 @@ private:
 		{ 0b010101010101010101011110, 24, 0 },
 		{ },
 		{ 37 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k192_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 
 	OOKClockRecovery clock_recovery_ook_8k4 {
 		channel_sample_rate / 8400.0f
 	};
 
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_ook_8k4_schrader {
+	void ook_8k4_schrader_handler(const baseband::Packet& packet);
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, PacketHandler<TPMSProcessor, &TPMSProcessor::ook_8k4_schrader_handler>> packet_builder_ook_8k4_schrader {
 		/* Preamble: 01*40, 01, 10, 01, 01
 		 * Payload: 76 Manchester-encoded bits
 		 * Bit rate: 4200 Hz
@@ -133,10 +130,7 @@ private:
 		{ 0b01010101010101010101010101100101, 32, 0 },
 		{ },
 		{ 76 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k4_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 };
 
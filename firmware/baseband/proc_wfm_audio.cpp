@@ -26,6 +26,7 @@
 #include "audio_output.hpp"
 #include "dsp_fft.hpp"
 #include "event_m4.hpp"
+#include "cycle_profiler.hpp"
 
 #include <cstdint>
 
@@ -34,17 +35,21 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 	
+	PROFILE_BEGIN(Decimate);
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
 	const auto channel = decim_1.execute(decim_0_out, dst_buffer);
+	PROFILE_END(Decimate);
 
 	// TODO: Feed channel_stats post-decimation data?
 	feed_channel_stats(channel);
 
+	PROFILE_BEGIN(Spectrum);
 	spectrum_samples += channel.count;
 	if( spectrum_samples >= spectrum_interval_samples ) {
 		spectrum_samples -= spectrum_interval_samples;
 		channel_spectrum.feed(channel, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
 	}
+	PROFILE_END(Spectrum);
 
 	/* 384kHz complex<int16_t>[256]
 	 * -> FM demodulation
@@ -53,6 +58,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 	 *		pass < +/- 100kHz, stop > +/- 200kHz
 	 */
 
+	PROFILE_BEGIN(Demod);
 	auto audio_oversampled = demod.execute(channel, work_audio_buffer);
 
 	/* 384kHz int16_t[256]
@@ -64,10 +70,12 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 	 * -> 4th order CIC decimation by 2, gain of 1
 	 * -> 96kHz int16_t[64] */
 	auto audio_2fs = audio_dec_2.execute(audio_4fs, work_audio_buffer);
+	PROFILE_END(Demod);
 
 	// Shit C++. Shit auto.
 	std::complex<float> corrected_sample;
 
+	PROFILE_BEGIN(Spectrum);
 	if(audio_fft_type == 0) {
 
 		// Input: 96kHz int16_t[64]
@@ -135,11 +143,16 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		}
 	}
 
+	PROFILE_END(Spectrum);
+
 	/* 96kHz int16_t[64]
 	 * -> FIR filter, <15kHz (0.156fs) pass, >19kHz (0.198fs) stop, gain of 1
 	 * -> 48kHz int16_t[32] */
+	PROFILE_BEGIN(Filter);
 	auto audio = audio_filter.execute(audio_2fs, work_audio_buffer);
+	PROFILE_END(Filter);
 
+	PROFILE_BEGIN(Spectrum);
 	if(audio_fft_type == 1) {
 
 		// Input: 48kHz int16_t[32]
@@ -213,8 +226,12 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		}
 	}
 
+	PROFILE_END(Spectrum);
+
 	/* -> 48kHz int16_t[32] */
+	PROFILE_BEGIN(Audio);
 	audio_output.write(audio);
+	PROFILE_END(Audio);
 	
 }
 
@@ -89,7 +89,12 @@ void WidebandSpectrum::on_message(const Message* const msg) {
 	
 	switch(msg->id) {
 	case Message::ID::UpdateSpectrum:
+		channel_spectrum.on_message(msg);
+		break;
+
 	case Message::ID::SpectrumStreamingConfig:
+		// Start summing afresh, the M0 usually retunes between stop and start
+		phase = 0;
 		channel_spectrum.on_message(msg);
 		break;
 		
@@ -33,6 +33,10 @@ public:
 	RSSIThread(const tprio_t priority);
 	~RSSIThread();
 
+	static const Thread* running_thread() {
+		return thread;
+	}
+
 private:
 	void run() override;
 
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SCAN_MEASUREMENT_COLLECTOR_H__
+#define __SCAN_MEASUREMENT_COLLECTOR_H__
+
+#include "dsp_types.hpp"
+#include "utility.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <hal.h>
+
+/* Answers the M0 scanner's post-retune measurement requests: skips samples
+ * still in flight from the previous frequency, then reports peak channel
+ * power over a short window through shared memory, without any message.
+ */
+class ScanMeasurementCollector {
+public:
+	void feed(const buffer_c16_t& src) {
+		auto& request = shared_memory.scan_measurement;
+
+		const uint32_t id = request.request_id;
+		if( id == request.done_id ) {
+			return;
+		}
+
+		if( id != current_id ) {
+			current_id = id;
+			max_squared = 0;
+			count = 0;
+		}
+
+		const size_t settle_samples = samples_for(src.sampling_rate, request.settle_us);
+		const size_t window_samples = samples_for(src.sampling_rate, request.window_us);
+
+		if( count >= settle_samples ) {
+			void *src_p = src.p;
+			while(src_p < &src.p[src.count]) {
+				const uint32_t sample = *__SIMD32(src_p)++;
+				const uint32_t mag_sq = __SMUAD(sample, sample);
+				if( mag_sq > max_squared ) {
+					max_squared = mag_sq;
+				}
+			}
+		}
+		count += src.count;
+
+		if( count >= (settle_samples + window_samples) ) {
+			const float max_squared_f = max_squared;
+			request.max_db = mag2_to_dbv_norm(max_squared_f * (1.0f / (32768.0f * 32768.0f)));
+			request.done_id = id;
+		}
+	}
+
+private:
+	uint32_t current_id { 0 };
+	uint32_t max_squared { 0 };
+	size_t count { 0 };
+
+	static size_t samples_for(const uint32_t sampling_rate, const uint32_t us) {
+		return (static_cast<uint64_t>(sampling_rate) * us) / 1000000;
+	}
+};
+
+#endif/*__SCAN_MEASUREMENT_COLLECTOR_H__*/
@@ -22,22 +22,15 @@
 
 #include "tv_collector.hpp"
 
-#include "dsp_fft.hpp"
-
 #include "utility.hpp"
 #include "event_m4.hpp"
 #include "portapack_shared_memory.hpp"
 
-#include "event_m4.hpp"
-
 #include <algorithm>
+#include <cstdlib>
 
 void TvCollector::on_message(const Message* const message) {
 	switch(message->id) {
-	case Message::ID::UpdateSpectrum:
-		update();
-		break;
-
 	case Message::ID::SpectrumStreamingConfig:
 		set_state(*reinterpret_cast<const SpectrumStreamingConfigMessage*>(message));
 		break;
@@ -57,7 +50,7 @@ void TvCollector::set_state(const SpectrumStreamingConfigMessage& message) {
 
 void TvCollector::start() {
 	streaming = true;
-	ChannelSpectrumConfigMessage message { &fifo };
+	TVLinesConfigMessage message { &fifo };
 	shared_memory.application_queue.push(message);
 }
 
@@ -66,55 +59,147 @@ void TvCollector::stop() {
 	fifo.reset_in();
 }
 
-void TvCollector::set_decimation_factor(
-	const size_t decimation_factor
-) {
-	channel_spectrum_decimator.set_factor(decimation_factor);
-}
-
-/* TODO: Refactor to register task with idle thread?
- * It's sad that the idle thread has to call all the way back here just to
- * perform the deferred task on the buffer of data we prepared.
- */
-
 void TvCollector::feed(
-	const buffer_c16_t& channel
+	const buffer_c8_t& buffer
 ) {
 	// Called from baseband processing thread.
-	channel_spectrum_decimator.feed(channel,[this](const buffer_c16_t& data) {this->post_message(data);});
-}
+	for(size_t i=0; i<buffer.count; i++) {
+		if( skip ) {
+			skip--;
+			continue;
+		}
 
-void TvCollector::post_message(const buffer_c16_t& data) {
-	// Called from baseband processing thread.
-        float re, im;
-	float mag;
-	if( streaming && !channel_spectrum_request_update ) {
-                for(size_t i=0; i<256; i++) 
-		{
-                        re = (float)(data.p[i].real());
-			im = (float)(data.p[i].imag());
-			mag = __builtin_sqrtf((re * re) + (im * im)) ;
-			channel_spectrum[i] = {mag, mag};
+		// Magnitude, alpha max + beta min with beta = 3/8
+		const int32_t re = std::abs(buffer.p[i].real());
+		const int32_t im = std::abs(buffer.p[i].imag());
+		const int32_t mag_max = std::max(re, im);
+		const int32_t mag_min = std::min(re, im);
+		line[line_fill++] = mag_max + ((mag_min * 3) >> 3);
+
+		if( line_fill >= line_target ) {
+			process_line();
 		}
-                channel_spectrum_sampling_rate = data.sampling_rate;
-		channel_spectrum_request_update = true;
-		EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
 	}
 }
 
+void TvCollector::process_line() {
+	const size_t length = line_fill;
+	line_fill = 0;
+	line_target = line_length;
+
+	// Sync tip: the strongest sync-wide boxcar in the line
+	uint32_t sum = 0;
+	uint32_t best_sum = 0;
+	size_t best_pos = 0;
+	for(size_t i=0; i<length; i++) {
+		sum += line[i];
+		if( i >= sync_length ) {
+			sum -= line[i - sync_length];
+		}
+		if( (i + 1 >= sync_length) && (sum > best_sum) ) {
+			best_sum = sum;
+			best_pos = i + 1 - sync_length;
+		}
+	}
+	const uint32_t tip = best_sum / sync_length;
+	const uint32_t sync_threshold = (tip * 7) / 8;
+
+	// Broad pulses (vertical sync) stay at sync level much longer than a line sync
+	size_t run = 0;
+	size_t broad_start = length;
+	for(size_t i=0; i<length; i++) {
+		if( line[i] >= sync_threshold ) {
+			if( ++run == broad_run ) {
+				broad_start = i + 1 - broad_run;
+				break;
+			}
+		} else {
+			run = 0;
+		}
+	}
+	const bool broad = (broad_start < length);
+
+	// Back porch is at blanking level, about 3/4 of the sync tip
+	uint32_t black = (tip * 3) / 4;
+	const size_t porch = best_pos + porch_start;
+	if( porch + porch_length <= length ) {
+		uint32_t porch_sum = 0;
+		for(size_t i=porch; i<porch + porch_length; i++) {
+			porch_sum += line[i];
+		}
+		black = porch_sum / porch_length;
+	}
+	const bool sync_valid = !broad && (tip >= 16) && (black * 8 < tip * 7) && (black * 2 > tip);
+
+	const int32_t error = (best_pos < length / 2) ? (int32_t)best_pos : (int32_t)best_pos - (int32_t)length;
+	track_sync(sync_valid, error);
 
-void TvCollector::update() {
-	// Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
-	if( streaming && channel_spectrum_request_update ) {
-		ChannelSpectrum spectrum;
-		spectrum.sampling_rate = channel_spectrum_sampling_rate;
-		for(size_t i=0; i<spectrum.db.size(); i++) {
-                        const auto corrected_sample = channel_spectrum[i].real();
-			const unsigned int v = corrected_sample + 127.0f;
-			spectrum.db[i] = std::max(0U, std::min(255U, v));
+	if( broad ) {
+		if( !in_vsync ) {
+			// First field's broad pulses start with a line, the second's half-way through
+			field_shown = (broad_start < line_length / 4) || (broad_start > (line_length * 3) / 4);
+			in_vsync = true;
 		}
-		fifo.in(spectrum);
+		line_number = 0;
+		return;
+	}
+
+	if( in_vsync ) {
+		in_vsync = false;
+		line_number = 3;		// Last broad line, equalizing pulses follow
+	}
+
+	line_number++;
+	if( line_number > max_field_lines ) {
+		// No vertical sync, free run and show everything
+		line_number = 0;
+		field_shown = true;
+	}
+
+	if( streaming && field_shown &&
+		(line_number >= first_active_line) && (line_number <= last_active_line) &&
+		!((line_number - first_active_line) % row_decimation) ) {
+		post_line(black, tip / 8);
+	}
+}
+
+void TvCollector::track_sync(const bool valid, const int32_t error) {
+	int32_t adjust = 0;
+
+	if( valid && !locked ) {
+		// Acquire: next window starts right on the sync
+		adjust = error;
+		phase_error = 0;
+		locked = true;
+		misses = 0;
+	} else if( valid && (std::abs(error) <= lock_window) ) {
+		// Tracking: first order loop, keeps fractional errors for later lines
+		phase_error += error;
+		adjust = phase_error / 4;
+		phase_error -= adjust * 4;
+		misses = 0;
+	} else if( ++misses >= unlock_misses ) {
+		locked = false;
+	}
+
+	if( adjust > 0 ) {
+		skip = adjust;
+	} else if( adjust < 0 ) {
+		line_target = line_length + adjust;
+	}
+}
+
+void TvCollector::post_line(const uint32_t black, const uint32_t white) {
+	TVLine tv_line;
+	tv_line.row = (line_number - first_active_line) / row_decimation;
+
+	// Negative modulation: black at porch level, white near the carrier floor
+	const int32_t span = std::max<int32_t>(black - white, 1);
+	const int32_t gain = (255 << 16) / span;
+	for(size_t x=0; x<TVLine::width; x++) {
+		const int32_t v = (((int32_t)black - line[active_start + x]) * gain) >> 16;
+		tv_line.pixels[x] = std::max<int32_t>(0, std::min<int32_t>(255, v));
 	}
 
-	channel_spectrum_request_update = false;
+	fifo.in(tv_line);
 }
@@ -26,41 +26,63 @@
 #include "dsp_types.hpp"
 #include "complex.hpp"
 
-#include "block_decimator.hpp"
-
 #include <cstdint>
 #include <array>
 
 #include "message.hpp"
 
+/* Locks onto the syncs of a negative-modulation AM TV signal sampled at 2MS/s,
+ * and hands the M0 sync-aligned, decimated lines of one field per frame.
+ * Horizontal: each line's sync tip is found with a boxcar correlation, and the
+ * start of the next line window is pulled towards it.
+ * Vertical: broad pulses mark the start of a field. Where they begin within the
+ * line (start or middle) tells the two interlaced fields apart.
+ */
 class TvCollector {
 public:
 	void on_message(const Message* const message);
 
-	void set_decimation_factor(const size_t decimation_factor);
-
 	void feed(
-		const buffer_c16_t& channel
+		const buffer_c8_t& buffer
 	);
 
 private:
-	BlockDecimator<complex16_t, 256> channel_spectrum_decimator { 1 };
-	ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k] { };
-	ChannelSpectrumFIFO fifo { fifo_data, ChannelSpectrumConfigMessage::fifo_k };
+	static constexpr size_t line_length = 128;		// 64us
+	static constexpr size_t sync_length = 9;		// 4.7us
+	static constexpr size_t porch_start = 11;		// Back porch, black level reference
+	static constexpr size_t porch_length = 8;
+	static constexpr size_t active_start = 21;		// 10.5us after the sync leading edge
+	static constexpr size_t broad_run = 32;			// Broad pulses are 27us long
+	static constexpr size_t first_active_line = 23;
+	static constexpr size_t last_active_line = 309;
+	static constexpr size_t max_field_lines = 320;
+	static constexpr size_t row_decimation = 3;
+	static constexpr int32_t lock_window = 8;
+	static constexpr size_t unlock_misses = 16;
 
-	volatile bool channel_spectrum_request_update { false };
+	TVLine fifo_data[1 << TVLinesConfigMessage::fifo_k] { };
+	TVLineFIFO fifo { fifo_data, TVLinesConfigMessage::fifo_k };
 	bool streaming { false };
-	std::array<std::complex<float>, 256> channel_spectrum { };
-	uint32_t channel_spectrum_sampling_rate { 0 };
 
-	void post_message(const buffer_c16_t& data);
+	std::array<uint8_t, line_length> line { };
+	size_t line_fill { 0 };
+	size_t line_target { line_length };
+	size_t skip { 0 };
+	int32_t phase_error { 0 };
+	bool locked { false };
+	size_t misses { 0 };
+
+	size_t line_number { 0 };
+	bool in_vsync { false };
+	bool field_shown { true };
 
 	void set_state(const SpectrumStreamingConfigMessage& message);
 	void start();
 	void stop();
 
-	void update();
-
+	void process_line();
+	void track_sync(const bool valid, const int32_t error);
+	void post_line(const uint32_t black, const uint32_t white);
 };
 
 #endif/*__TV_COLLECTOR_H__*/
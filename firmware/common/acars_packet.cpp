@@ -33,75 +33,86 @@ size_t Packet::length() const {
 }
 
 bool Packet::is_valid() const {
-	return true;	//length_valid() && crc_ok();
+	return length_valid() && crc_ok();
 }
 
 Timestamp Packet::received_at() const {
 	return packet_.timestamp();
 }
 
+uint8_t Packet::mode() const {
+	return character(1);
+}
+
 uint8_t Packet::block_id() const {
-	return field_.read(96, 8);
+	return character(12);
 }
 
 std::string Packet::registration_number() const {
-	std::string result;
-	result.reserve(7);
-	
-	const size_t character_length = 8;
-	for(size_t i=16; i<(16+7*character_length); i+=character_length) {
-		result += (field_.read(i, character_length) & 0x7F);
+	return text(registration_number_field);
+}
+
+std::string Packet::label() const {
+	return text(label_field);
+}
+
+std::string Packet::message_text() const {
+	return text(message_text_field());
+}
+
+Packet::Field Packet::message_text_field() const {
+	// Text is only there if block ID is followed by STX, it stops at ETX/ETB
+	if( (character_count() < 17) || (character(13) != stx) ) {
+		return { 14, 0 };
 	}
 
-	return result;
+	return { 14, character_count() - 17 };
+}
+
+char Packet::printable_character(const size_t index) const {
+	const char c = character(index);
+	return ((c < ' ') || (c == 0x7F)) ? '.' : c;
 }
 
 uint32_t Packet::read(const size_t start_bit, const size_t length) const {
 	return field_.read(start_bit, length);
 }
 
-/*std::string Packet::text(
-	const size_t start_bit,
-	const size_t character_count
+std::string Packet::text(
+	const Field field
 ) const {
 	std::string result;
-	result.reserve(character_count);
-	
-	const size_t character_length = 6;
-	const size_t end_bit = start_bit + character_count * character_length;
-	for(size_t i=start_bit; i<end_bit; i+=character_length) {
-		result += char_to_ascii(field_.read(i, character_length));
-	} 
+	result.reserve(field.count);
+
+	for(size_t i=field.start; i<(field.start + field.count); i++) {
+		result += printable_character(i);
+	}
 
 	return result;
-}*/
+}
 
+// Same check as on the baseband: mode up to the BCS leaves a zero remainder
 bool Packet::crc_ok() const {
-	CRCReader field_crc { packet_ };
-	CRC<16> acars_fcs { 0x1021, 0x0000, 0x0000 };
-	
-	for(size_t i=0; i<data_length(); i+=8) {
-		acars_fcs.process_byte(field_crc.read(i, 8));
+	CRC<16, true, true> acars_bcs { 0x1021, 0x0000, 0x0000 };
+
+	for(size_t i=1; i<character_count(); i++) {
+		acars_bcs.process_byte(field_.read(i * 8, 8));
 	}
 
-	return (acars_fcs.checksum() == field_crc.read(data_length(), fcs_length));
+	return (acars_bcs.checksum() == 0);
 }
 
-size_t Packet::data_and_fcs_length() const {
-	return length() - 8;
+uint8_t Packet::character(const size_t index) const {
+	return field_.read(index * 8, 8) & 0x7F;
 }
 
-size_t Packet::data_length() const {
-	return data_and_fcs_length() - fcs_length;
+size_t Packet::character_count() const {
+	return length() / 8;
 }
 
 bool Packet::length_valid() const {
-	const size_t extra_bits = data_and_fcs_length() & 7;
-	if( extra_bits != 0 ) {
-		return false;
-	}
-
-	return true;
+	// SOH, 12 header characters, ETX and the BCS at least
+	return ((length() & 7) == 0) && (character_count() >= 16);
 }
 
-} /* namespace ais */
+} /* namespace acars */
@@ -47,25 +47,47 @@ public:
 
 	Timestamp received_at() const;
 
+	uint8_t mode() const;
 	uint8_t block_id() const;
 	std::string registration_number() const;
+	std::string label() const;
+	std::string message_text() const;
+
+	/* Text fields as character ranges, for formatting them without building
+	 * strings: printable_character() over a field gives the same characters
+	 * as the std::string accessors above.
+	 */
+	struct Field {
+		size_t start;
+		size_t count;
+	};
+
+	static constexpr Field registration_number_field { 2, 7 };
+	static constexpr Field label_field { 10, 2 };
+	Field message_text_field() const;
+
+	// Control characters come out as '.'
+	char printable_character(const size_t index) const;
 
 	uint32_t read(const size_t start_bit, const size_t length) const;
-	//std::string text(const size_t start_bit, const size_t character_count) const;
 
 	bool crc_ok() const;
 
 private:
 	using Reader = FieldReader<baseband::Packet, BitRemapByteReverse>;
-	using CRCReader = FieldReader<baseband::Packet, BitRemapNone>;
-	
+
+	/* Packets come from the baseband as SOH, mode, registration (7), ACK,
+	 * label (2), block ID, then optionally STX and text, then ETX/ETB and the
+	 * BCS. Characters are 7-bit ASCII plus odd parity in the top bit.
+	 */
+	static constexpr uint8_t stx = 0x02;
+
 	const baseband::Packet packet_;
 	const Reader field_;
 
-	const size_t fcs_length = 16;
-
-	size_t data_and_fcs_length() const;
-	size_t data_length() const;
+	std::string text(const Field field) const;
+	uint8_t character(const size_t index) const;
+	size_t character_count() const;
 
 	bool length_valid() const;
 };
@@ -73,6 +73,10 @@ public:
 		return payload_size;
 	}
 
+	const uint8_t* data() const {
+		return payload;
+	}
+
 	void set_valid_checksum(const bool valid) {
 		valid_checksum = valid;
 	}
@@ -70,4 +70,44 @@ private:
 	size_t maximum_hanning_distance_;
 };
 
+/* Sync word matcher for patterns of up to 32 bits. Compares the whole word in
+ * one go against the low 32 bits of the history, tolerating up to
+ * maximum_hanning_distance flipped bits. Cheaper than BitPattern on the M4,
+ * which has no 64-bit popcount.
+ */
+class SyncWord {
+public:
+	constexpr SyncWord(
+	) : code_ { 0 },
+		mask_ { 0 },
+		maximum_hanning_distance_ { 0 }
+	{
+	}
+
+	constexpr SyncWord(
+		const uint32_t code,
+		const size_t code_length,
+		const size_t maximum_hanning_distance = 0
+	) : code_ { code },
+		mask_ { static_cast<uint32_t>((1ULL << code_length) - 1ULL) },
+		maximum_hanning_distance_ { maximum_hanning_distance }
+	{
+	}
+
+	bool operator()(const BitHistory& history, const size_t) const {
+		return matches(static_cast<uint32_t>(history.value()));
+	}
+
+	bool matches(const uint32_t word) const {
+		const uint32_t delta_bits = (word ^ code_) & mask_;
+		const size_t count = __builtin_popcount(delta_bits);
+		return (count <= maximum_hanning_distance_);
+	}
+
+private:
+	uint32_t code_;
+	uint32_t mask_;
+	size_t maximum_hanning_distance_;
+};
+
 #endif/*__BIT_PATTERN_H__*/
@@ -442,6 +442,42 @@ constexpr fir_taps_real<64> taps_64_lp_156_198 {
 	} },
 };
 
+// ACARS channel decimation filters //////////////////////////////////////
+
+// IFIR prototype filter: fs=614400, pass=5000, stop=71800, decim=8, fout=76800
+static constexpr fir_taps_real<32> taps_acars_decim_1 = {
+	.low_frequency_normalized = -5000.0f / 614400.0f,
+	.high_frequency_normalized = 5000.0f / 614400.0f,
+	.transition_normalized = 66800.0f / 614400.0f,
+	.taps = { {
+	    -6,    -31,    -77,   -142,   -210,   -251,   -227,    -95,
+	   179,    613,   1194,   1876,   2588,   3237,   3734,   4002,
+	  4002,   3734,   3237,   2588,   1876,   1194,    613,    179,
+	   -95,   -227,   -251,   -210,   -142,    -77,    -31,     -6,
+	} },
+};
+
+// Channel filter: fs=76800, pass=5000, stop=12500, decim=2, fout=38400
+static constexpr fir_taps_complex<48> taps_acars_decim_2 = {
+	.low_frequency_normalized = -5000.0f / 76800.0f,
+	.high_frequency_normalized = 5000.0f / 76800.0f,
+	.transition_normalized = 7500.0f / 76800.0f,
+	.taps = { {
+		{     -7,      0 }, {     -7,      0 }, {     10,      0 }, {     46,      0 },
+		{     81,      0 }, {     76,      0 }, {     -7,      0 }, {   -159,      0 },
+		{   -310,      0 }, {   -334,      0 }, {   -125,      0 }, {    309,      0 },
+		{    788,      0 }, {   1002,      0 }, {    653,      0 }, {   -323,      0 },
+		{  -1613,      0 }, {  -2538,      0 }, {  -2295,      0 }, {   -331,      0 },
+		{   3312,      0 }, {   7872,      0 }, {  12074,      0 }, {  14594,      0 },
+		{  14594,      0 }, {  12074,      0 }, {   7872,      0 }, {   3312,      0 },
+		{   -331,      0 }, {  -2295,      0 }, {  -2538,      0 }, {  -1613,      0 },
+		{   -323,      0 }, {    653,      0 }, {   1002,      0 }, {    788,      0 },
+		{    309,      0 }, {   -125,      0 }, {   -334,      0 }, {   -310,      0 },
+		{   -159,      0 }, {     -7,      0 }, {     76,      0 }, {     81,      0 },
+		{     46,      0 }, {     10,      0 }, {     -7,      0 }, {     -7,      0 },
+	} },
+};
+
 // TPMS decimation filters ////////////////////////////////////////////////
 
 // IFIR image-reject filter: fs=2457600, pass=100000, stop=407200, decim=4, fout=614400
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ * Copyright (C) 2016 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __HDLC_DEFRAMER_H__
+#define __HDLC_DEFRAMER_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace hdlc {
+
+/* CRC-16/X.25 as used by the HDLC FCS: reflected 0x1021, init 0xFFFF.
+ * Running it over a frame and its FCS leaves fcs_residue.
+ */
+constexpr uint16_t fcs_init = 0xFFFF;
+constexpr uint16_t fcs_residue = 0xF0B8;
+
+using fcs_table_t = std::array<uint16_t, 256>;
+
+constexpr fcs_table_t make_fcs_table() {
+	fcs_table_t table { };
+	for(size_t i=0; i<table.size(); i++) {
+		uint16_t crc = i;
+		for(size_t n=0; n<8; n++) {
+			crc = (crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+		}
+		table[i] = crc;
+	}
+	return table;
+}
+
+inline constexpr fcs_table_t fcs_table = make_fcs_table();
+
+inline uint16_t fcs_update(const uint16_t crc, const uint8_t byte) {
+	return (crc >> 8) ^ fcs_table[(crc ^ byte) & 0xFF];
+}
+
+/* Unstuffing and flag/abort detection, four decoded bits per lookup.
+ * The state is the current run of ones (0..6, 7 once aborted). Ones that
+ * make up a flag or an abort never come out, neither do stuffed zeros. Bits
+ * before and after a flag or abort come out separately, a nibble can't hold
+ * two of them.
+ *
+ *  0..3	bits before the event, first bit in the LSB
+ *  4..6	count of bits before the event
+ *  7..8	event
+ *  9..12	bits after the event
+ * 13..15	count of bits after the event
+ * 16..18	next state
+ */
+enum class Event : uint8_t {
+	None = 0,
+	Flag = 1,
+	Abort = 2,
+};
+
+constexpr uint32_t make_unstuff_entry(const size_t state, const uint8_t nibble) {
+	size_t ones = state;
+	uint32_t event = 0;
+	uint32_t bits[2] { 0, 0 };
+	uint32_t count[2] { 0, 0 };
+
+	for(size_t i=0; i<4; i++) {
+		const size_t part = event ? 1 : 0;
+		if( (nibble >> i) & 1 ) {
+			if( ones < 5 ) {
+				bits[part] |= 1 << count[part]++;
+			} else if( ones == 6 ) {
+				event = static_cast<uint32_t>(Event::Abort);
+			}
+			if( ones < 7 ) {
+				ones++;
+			}
+		} else {
+			if( ones == 6 ) {
+				event = static_cast<uint32_t>(Event::Flag);
+			} else if( ones < 5 ) {
+				count[part]++;
+			}
+			ones = 0;
+		}
+	}
+
+	return bits[0] | (count[0] << 4) | (event << 7) | (bits[1] << 9) | (count[1] << 13) | (ones << 16);
+}
+
+using unstuff_table_t = std::array<uint32_t, 8 * 16>;
+
+constexpr unstuff_table_t make_unstuff_table() {
+	unstuff_table_t table { };
+	for(size_t state=0; state<8; state++) {
+		for(size_t nibble=0; nibble<16; nibble++) {
+			table[(state << 4) | nibble] = make_unstuff_entry(state, nibble);
+		}
+	}
+	return table;
+}
+
+inline constexpr unstuff_table_t unstuff_table = make_unstuff_table();
+
+/* NRZI line bits in, FCS-checked frames out (FCS included in size()).
+ * Bits go through NRZI decoding and unstuffing a nibble at a time, the FCS is
+ * updated a byte at a time as the frame comes in. A completed frame stays in
+ * data()/size() until the next call.
+ */
+class Deframer {
+public:
+	static constexpr size_t max_size = 256;
+
+	// One line bit, true when a good frame just ended
+	bool execute(const uint8_t bit) {
+		line_bits |= (bit & 1) << line_count;
+		if( ++line_count < 4 ) {
+			return false;
+		}
+
+		const auto nibble = line_bits;
+		line_bits = 0;
+		line_count = 0;
+		return execute_nibble(nibble);
+	}
+
+	// Eight line bits, first one in the LSB
+	bool execute_byte(const uint8_t bits) {
+		const bool low = execute_nibble(bits & 0xF);
+		const bool high = execute_nibble(bits >> 4);
+		return low || high;
+	}
+
+	const uint8_t* data() const {
+		return buffer.data();
+	}
+
+	size_t size() const {
+		return frame_size;
+	}
+
+private:
+	std::array<uint8_t, max_size> buffer { };
+	size_t frame_size { 0 };
+
+	uint8_t line_bits { 0 };
+	uint8_t line_count { 0 };
+	uint8_t last_line_bit { 0 };
+	uint8_t unstuff_state { 0 };
+
+	bool in_frame { false };
+	uint32_t bit_buffer { 0 };
+	size_t bit_count { 0 };		// Since the last flag
+	size_t byte_count { 0 };
+	uint16_t fcs { fcs_init };
+
+	bool execute_nibble(const uint8_t line_nibble) {
+		// NRZI: no transition is a 1
+		const uint8_t decoded = ~(line_nibble ^ ((line_nibble << 1) | last_line_bit)) & 0xF;
+		last_line_bit = (line_nibble >> 3) & 1;
+
+		const auto entry = unstuff_table[(unstuff_state << 4) | decoded];
+		unstuff_state = (entry >> 16) & 7;
+
+		add_bits(entry & 0xF, (entry >> 4) & 7);
+
+		bool done = false;
+		switch( static_cast<Event>((entry >> 7) & 3) ) {
+		case Event::Flag:
+			done = end_frame();
+			start_frame();
+			break;
+
+		case Event::Abort:
+			in_frame = false;
+			break;
+
+		default:
+			return false;
+		}
+
+		add_bits((entry >> 9) & 0xF, (entry >> 13) & 7);
+		return done;
+	}
+
+	void add_bits(const uint32_t bits, const size_t count) {
+		if( !in_frame ) {
+			return;
+		}
+
+		bit_buffer |= bits << (bit_count & 7);
+		bit_count += count;
+
+		if( (bit_count & ~7) != ((bit_count - count) & ~7) ) {
+			if( byte_count == buffer.size() ) {
+				in_frame = false;
+				return;
+			}
+			const uint8_t byte = bit_buffer & 0xFF;
+			buffer[byte_count++] = byte;
+			fcs = fcs_update(fcs, byte);
+			bit_buffer >>= 8;
+		}
+	}
+
+	// Closing flag: its first six bits have come out as data already
+	bool end_frame() {
+		if( !in_frame || ((bit_count & 7) != 6) || (byte_count < 3) || (fcs != fcs_residue) ) {
+			return false;
+		}
+		frame_size = byte_count;
+		return true;
+	}
+
+	void start_frame() {
+		in_frame = true;
+		bit_buffer = 0;
+		bit_count = 0;
+		byte_count = 0;
+		fcs = fcs_init;
+	}
+};
+
+} /* namespace hdlc */
+
+#endif/*__HDLC_DEFRAMER_H__*/
@@ -719,6 +719,45 @@ void ILI9341::draw_glyph(
 	draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background);
 }
 
+void ILI9341::draw_glyphs(
+	const ui::Point p,
+	const ui::Size glyph_size,
+	const TextGlyph* const glyphs,
+	const size_t count,
+	const ui::Color background
+) {
+	if( count == 0 ) {
+		return;
+	}
+
+	const size_t glyph_width = glyph_size.width();
+	lcd_start_ram_write(p, { static_cast<int>(count * glyph_width), glyph_size.height() });
+
+	ui::Color run_color = background;
+	size_t run_length = 0;
+
+	// Glyph bitmaps are packed LSB first, row after row, with no padding
+	size_t row_start = 0;
+	for(int y=0; y<glyph_size.height(); y++) {
+		for(size_t g=0; g<count; g++) {
+			const auto pixels = glyphs[g].pixels;
+			const auto foreground = glyphs[g].foreground;
+			for(size_t i=row_start; i<row_start + glyph_width; i++) {
+				const auto color = (pixels[i >> 3] & (1U << (i & 0x7))) ? foreground : background;
+				if( color.v != run_color.v ) {
+					io.lcd_write_pixels(run_color, run_length);
+					run_color = color;
+					run_length = 0;
+				}
+				run_length++;
+			}
+		}
+		row_start += glyph_width;
+	}
+
+	io.lcd_write_pixels(run_color, run_length);
+}
+
 void ILI9341::scroll_set_area(
 	const ui::Coord top_y,
 	const ui::Coord bottom_y
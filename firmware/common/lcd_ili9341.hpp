@@ -96,6 +96,23 @@ public:
 		const ui::Color background
 	);
 
+	struct TextGlyph {
+		const uint8_t* pixels;
+		ui::Color foreground;
+	};
+
+	/* Draws a row of same-size glyphs through a single LCD window, one
+	 * scanline across all of them at a time, writing each run of equal
+	 * pixels with one call.
+	 */
+	void draw_glyphs(
+		const ui::Point p,
+		const ui::Size glyph_size,
+		const TextGlyph* const glyphs,
+		const size_t count,
+		const ui::Color background
+	);
+
 	void scroll_set_area(const ui::Coord top_y, const ui::Coord bottom_y);
 	ui::Coord scroll_set_position(const ui::Coord position);
 	ui::Coord scroll(const int32_t delta);
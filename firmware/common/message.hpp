@@ -114,6 +114,10 @@ public:
 		AudioSpectrum = 53,
 		APRSPacket = 54,
 		APRSRxConfigure = 55,
+		PacketBatch = 56,
+		TVLinesConfig = 57,
+		ACARSConfigure = 58,
+		AFSKFrame = 59,
 		MAX
 	};
 
@@ -325,6 +329,32 @@ public:
 	ChannelSpectrumFIFO* fifo { nullptr };
 };
 
+/* One decimated, sync-aligned video line, brightness 0 (black) to 255 (white).
+ * row is the line's position in the picture, counted from the first active line.
+ */
+struct TVLine {
+	static constexpr size_t width = 104;	// 52us of active video at 2MS/s
+
+	uint16_t row { 0 };
+	std::array<uint8_t, width> pixels { { 0 } };
+};
+
+using TVLineFIFO = FIFO<TVLine>;
+
+class TVLinesConfigMessage : public Message {
+public:
+	static constexpr size_t fifo_k = 6;
+
+	constexpr TVLinesConfigMessage(
+		TVLineFIFO* fifo
+	) : Message { ID::TVLinesConfig },
+		fifo { fifo }
+	{
+	}
+
+	TVLineFIFO* fifo { nullptr };
+};
+
 class AISPacketMessage : public Message {
 public:
 	constexpr AISPacketMessage(
@@ -367,13 +397,35 @@ public:
 class ACARSPacketMessage : public Message {
 public:
 	constexpr ACARSPacketMessage(
-		const baseband::Packet& packet
+		const baseband::Packet& packet,
+		const uint8_t channel
 	) : Message { ID::ACARSPacket },
-		packet { packet }
+		packet { packet },
+		channel { channel }
 	{
 	}
 
 	baseband::Packet packet;
+	uint8_t channel;
+};
+
+// Channel offsets are in Hz from the tuned frequency
+class ACARSConfigureMessage : public Message {
+public:
+	static constexpr size_t max_channels = 4;
+	static constexpr int32_t max_offset = 200000;
+
+	constexpr ACARSConfigureMessage(
+		const std::array<int32_t, max_channels>& channel_offsets,
+		const size_t channel_count
+	) : Message { ID::ACARSConfigure },
+		channel_offsets { channel_offsets },
+		channel_count { channel_count }
+	{
+	}
+
+	std::array<int32_t, max_channels> channel_offsets;
+	size_t channel_count;
 };
 
 class ADSBFrameMessage : public Message {
@@ -403,6 +455,20 @@ public:
 	uint32_t value;
 };
 
+// One FCS-checked HDLC frame from AFSK RX, FCS stripped
+class AFSKFrameMessage : public Message {
+public:
+	static constexpr size_t max_size = 256;
+
+	constexpr AFSKFrameMessage(
+	) : Message { ID::AFSKFrame }
+	{
+	}
+
+	size_t size { 0 };
+	std::array<uint8_t, max_size> data { };
+};
+
 class CodedSquelchMessage : public Message {
 public:
 	constexpr CodedSquelchMessage(
@@ -548,18 +614,13 @@ public:
 		SSB = 1,
 	};
 
+	// Decimation taps are always the 6k0 set, the M4 has its own copy
 	constexpr AMConfigureMessage(
-		const fir_taps_real<24> decim_0_filter,
-		const fir_taps_real<32> decim_1_filter,
-		const fir_taps_real<32> decim_2_filter,
 		const fir_taps_complex<64> channel_filter,
 		const Modulation modulation,
 		const iir_biquad_config_t audio_hpf_config,
 		const uint8_t spec_zoom
 	) : Message { ID::AMConfigure },
-		decim_0_filter(decim_0_filter),
-		decim_1_filter(decim_1_filter),
-		decim_2_filter(decim_2_filter),
 		channel_filter(channel_filter),
 		modulation { modulation },
 		audio_hpf_config(audio_hpf_config),
@@ -567,9 +628,6 @@ public:
 	{
 	}
 
-	const fir_taps_real<24> decim_0_filter;
-	const fir_taps_real<32> decim_1_filter;
-	const fir_taps_real<32> decim_2_filter;
 	const fir_taps_complex<64> channel_filter;
 	const Modulation modulation;
 	const iir_biquad_config_t audio_hpf_config;
@@ -724,20 +782,17 @@ public:
 	constexpr AFSKRxConfigureMessage(
 		const uint32_t baudrate,
 		const uint32_t word_length,
-		const uint32_t trigger_value,
-		const bool trigger_word
+		const bool hdlc
 	) : Message { ID::AFSKRxConfigure },
 		baudrate(baudrate),
 		word_length(word_length),
-		trigger_value(trigger_value),
-		trigger_word(trigger_word)
+		hdlc(hdlc)
 	{
 	}
 	
 	const uint32_t baudrate;
-	const uint32_t word_length;
-	const uint32_t trigger_value;
-	const bool trigger_word;
+	const uint32_t word_length;		// Start/stop framed words only
+	const bool hdlc;				// AX.25 style HDLC frames instead of words
 };
 
 class APRSRxConfigureMessage : public Message {
@@ -758,18 +813,21 @@ public:
 		const uint32_t baudrate,
 		const uint32_t word_length,
 		const uint32_t trigger_value,
-		const bool trigger_word
+		const bool trigger_word,
+		const uint8_t channel_number
 	) : Message { ID::BTLERxConfigure },
 		baudrate(baudrate),
 		word_length(word_length),
 		trigger_value(trigger_value),
-		trigger_word(trigger_word)
+		trigger_word(trigger_word),
+		channel_number(channel_number)
 	{
     }
 	const uint32_t baudrate;
 	const uint32_t word_length;
 	const uint32_t trigger_value;
 	const bool trigger_word;
+	const uint8_t channel_number;
 };
 
 class NRFRxConfigureMessage : public Message {
@@ -885,8 +943,6 @@ public:
 		const uint32_t tone_key_delta,
 		const float tone_key_mix_weight,
 		const uint16_t speed,
-		const uint8_t bit_type,
-		const uint8_t channels,
 		const uint8_t mod_type
 	) : Message { ID::AudioTXConfig },
 		divider(divider),
@@ -895,8 +951,6 @@ public:
 		tone_key_delta(tone_key_delta),
 		tone_key_mix_weight(tone_key_mix_weight),
 		speed(speed),
-		bit_type(bit_type),
-		channels(channels),
 		mod_type(mod_type)
 	{
 	}
@@ -907,8 +961,6 @@ public:
 	const uint32_t tone_key_delta;
 	const float tone_key_mix_weight;
 	const uint16_t speed;
-	const uint8_t bit_type;
-	const uint8_t channels;
 	const uint8_t mod_type;
 };
 
@@ -978,12 +1030,14 @@ public:
 		const uint32_t stream_length,
 		const uint32_t samples_per_bit,
 		const uint8_t repeat,
-		const uint32_t pause_symbols
+		const uint32_t pause_symbols,
+		const bool streamed
 	) : Message { ID::OOKConfigure },
 		stream_length(stream_length),
 		samples_per_bit(samples_per_bit),
 		repeat(repeat),
-		pause_symbols(pause_symbols)
+		pause_symbols(pause_symbols),
+		streamed(streamed)
 	{
 	}
 
@@ -991,6 +1045,8 @@ public:
 	const uint32_t samples_per_bit;
 	const uint8_t repeat;
 	const uint32_t pause_symbols;
+	// Bits come from a ReplayConfig stream instead of shared_memory.bb_data
+	const bool streamed;
 };
 
 class SSTVConfigureMessage : public Message {
@@ -1056,6 +1112,93 @@ public:
 	aprs::APRSPacket packet;
 };
 
+/* Several decoder messages coalesced into one queue record. Each entry is a
+ * 32-bit byte count followed by the message itself, padded to a whole word.
+ */
+class PacketBatchMessage : public Message {
+public:
+	static constexpr size_t header_size = 8;
+	static constexpr size_t capacity = Message::MAX_SIZE - header_size;
+
+	class iterator {
+	public:
+		constexpr iterator(
+			uint32_t* const p
+		) : p { p }
+		{
+		}
+
+		Message* operator*() const {
+			return reinterpret_cast<Message*>(p + 1);
+		}
+
+		iterator& operator++() {
+			p += 1 + words(*p);
+			return *this;
+		}
+
+		bool operator!=(const iterator& other) const {
+			return p != other.p;
+		}
+
+	private:
+		uint32_t* p;
+	};
+
+	PacketBatchMessage(
+	) : Message { ID::PacketBatch }
+	{
+	}
+
+	bool append(const Message& message, const size_t size) {
+		const size_t entry_words = 1 + words(size);
+		if( (length / sizeof(uint32_t)) + entry_words > (capacity / sizeof(uint32_t)) ) {
+			return false;
+		}
+
+		uint32_t* const p = &data[length / sizeof(uint32_t)];
+		p[0] = size;
+		memcpy(&p[1], &message, size);
+		length += entry_words * sizeof(uint32_t);
+		count++;
+		return true;
+	}
+
+	void clear() {
+		count = 0;
+		length = 0;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	// Bytes actually in use, which is all the queue has to carry
+	size_t size() const {
+		return header_size + length;
+	}
+
+	iterator begin() {
+		return { &data[0] };
+	}
+
+	iterator end() {
+		return { &data[length / sizeof(uint32_t)] };
+	}
+
+	uint16_t count { 0 };
+	uint16_t length { 0 };
+	uint32_t data[capacity / sizeof(uint32_t)];
+
+private:
+	static constexpr size_t words(const size_t size) {
+		return (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+	}
+};
+
+// data is the last member and word aligned, so this pins it at header_size
+static_assert(sizeof(PacketBatchMessage) == PacketBatchMessage::header_size + sizeof(PacketBatchMessage::data), "header_size is not the offset of data");
+
 class ADSBConfigureMessage : public Message {
 public:
 	constexpr ADSBConfigureMessage(
@@ -31,6 +31,11 @@
 
 class MessageQueue {
 public:
+	struct Statistics {
+		uint32_t high_water;	// Most bytes ever queued, including record headers
+		uint32_t dropped;		// Messages rejected because the FIFO was full
+	};
+
 	MessageQueue() = delete;
 	MessageQueue(const MessageQueue&) = delete;
 	MessageQueue(MessageQueue&&) = delete;
@@ -51,6 +56,11 @@ public:
 		return push(&message, sizeof(message));
 	}
 
+	// Only the used part of a batch is copied into the FIFO
+	bool push(const PacketBatchMessage& message) {
+		return push(&message, message.size());
+	}
+
 	template<typename T>
 	bool push_and_wait(const T& message) {
 		const bool result = push(message);
@@ -77,10 +87,25 @@ public:
 	void reset() {
 		fifo.reset();
 	}
+
+	size_t capacity() const {
+		return fifo.size();
+	}
+
+	Statistics statistics() const {
+		return { high_water, dropped };
+	}
+
+	void reset_statistics() {
+		high_water = 0;
+		dropped = 0;
+	}
 	
 private:
 	FIFO<uint8_t> fifo;
 	Mutex mutex_write { };
+	volatile uint32_t high_water { 0 };
+	volatile uint32_t dropped { 0 };
 
 	Message* peek(std::array<uint8_t, Message::MAX_SIZE>& buf) {
 		Message* const p = reinterpret_cast<Message*>(buf.data());
@@ -103,9 +128,17 @@ private:
 	bool push(const void* const buf, const size_t len) {
 		chMtxLock(&mutex_write);
 		const auto result = fifo.in_r(buf, len);
+		const bool success = (result == len);
+		if( success ) {
+			const uint32_t used = fifo.len();
+			if( used > high_water ) {
+				high_water = used;
+			}
+		} else {
+			dropped = dropped + 1;
+		}
 		chMtxUnlock();
 
-		const bool success = (result == len);
 		if( success ) {
 			signal();
 		}
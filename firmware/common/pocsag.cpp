@@ -36,6 +36,8 @@ std::string bitrate_str(BitRate bitrate) {
 		case BitRate::FSK512:	return "512bps ";
 		case BitRate::FSK1200:	return "1200bps";
 		case BitRate::FSK2400:	return "2400bps";
+		case BitRate::FSK3200:	return "3200bps";
+		case BitRate::AUTO:		return "Auto   ";
 		default:				return "????";
 	}
 }
@@ -257,6 +259,14 @@ void pocsag_decode_batch(const POCSAGPacket& batch, POCSAGState * const state) {
 	for (size_t i = 0; i < 16; i++) {
 		codeword = batch[i];
 		
+		if (batch.failed(i)) {
+			// Uncorrectable: the type bit can't be trusted. Drop it outside of a message,
+			// otherwise keep its 20 bits so the rest of the text stays aligned.
+			if (state->mode == STATE_CLEAR)
+				continue;
+			codeword |= 0x80000000U;
+		}
+		
 		if (!(codeword & 0x80000000U)) {
 			// Address codeword
 			if (state->mode == STATE_CLEAR) {
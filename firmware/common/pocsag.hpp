@@ -68,11 +68,12 @@ struct POCSAGState {
 	std::string numout;
 };
 
-const pocsag::BitRate pocsag_bitrates[4] = {
+const pocsag::BitRate pocsag_bitrates[5] = {
 	pocsag::BitRate::FSK512,
 	pocsag::BitRate::FSK1200,
 	pocsag::BitRate::FSK2400,
-	pocsag::BitRate::FSK3200
+	pocsag::BitRate::FSK3200,
+	pocsag::BitRate::AUTO
 };
 
 std::string bitrate_str(BitRate bitrate);
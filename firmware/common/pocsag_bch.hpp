@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ * Copyright (C) 2016 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __POCSAG_BCH_H__
+#define __POCSAG_BCH_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace pocsag {
+namespace bch {
+
+/* BCH(31,21) + even parity, as used by POCSAG codewords.
+ * Bit 31 is the first bit on air, bits 31..11 are data, 10..1 are the BCH
+ * check bits and bit 0 is the even parity bit over the whole codeword.
+ *
+ * Correction is syndrome-table based: every single and double bit error
+ * pattern over the 31 BCH bits has a distinct 10-bit syndrome, so the table
+ * maps a syndrome straight to the bit positions to flip.
+ */
+
+constexpr uint32_t generator = 0x769;		// x^10 + x^9 + x^8 + x^6 + x^5 + x^3 + 1
+constexpr size_t check_bits = 10;
+constexpr size_t code_bits = 31;
+
+enum class Result : uint8_t {
+	Clean,
+	Corrected,
+	Failed
+};
+
+// Remainder of the 31 BCH bits (codeword >> 1) divided by the generator
+constexpr uint32_t syndrome(const uint32_t codeword) {
+	uint32_t r = codeword >> 1;
+	for(size_t i = code_bits - 1; i >= check_bits; i--) {
+		if( r & (1UL << i) ) {
+			r ^= generator << (i - check_bits);
+		}
+	}
+	return r;
+}
+
+/* Each entry holds up to two error positions (bit index in the 32-bit
+ * codeword, plus one, so that 0 means "none") packed as pos_a | (pos_b << 6).
+ * An all-zero entry for a non-zero syndrome means more than 2 errors.
+ */
+using syndrome_table_t = std::array<uint16_t, 1 << check_bits>;
+
+constexpr syndrome_table_t make_syndrome_table() {
+	syndrome_table_t table { };
+	for(size_t a = 1; a <= code_bits; a++) {
+		const uint32_t error_a = 1UL << a;
+		table[syndrome(error_a)] = a + 1;
+		for(size_t b = a + 1; b <= code_bits; b++) {
+			const uint32_t error_b = 1UL << b;
+			table[syndrome(error_a | error_b)] = (a + 1) | ((b + 1) << 6);
+		}
+	}
+	return table;
+}
+
+inline constexpr syndrome_table_t syndrome_table = make_syndrome_table();
+
+// Repairs up to 2 flipped bits in place (3 if one of them is the parity bit)
+inline Result correct(uint32_t& codeword) {
+	uint32_t repaired = codeword;
+	size_t flipped = 0;
+
+	const auto s = syndrome(repaired);
+	if( s ) {
+		const auto entry = syndrome_table[s];
+		if( !entry ) {
+			return Result::Failed;
+		}
+		repaired ^= 1UL << ((entry & 0x3f) - 1);
+		flipped++;
+		if( entry >> 6 ) {
+			repaired ^= 1UL << ((entry >> 6) - 1);
+			flipped++;
+		}
+	}
+
+	if( __builtin_popcount(repaired) & 1 ) {
+		// Parity error on top of two corrected bits is a third error
+		if( flipped == 2 ) {
+			return Result::Failed;
+		}
+		repaired ^= 1;
+		flipped++;
+	}
+
+	codeword = repaired;
+	return flipped ? Result::Corrected : Result::Clean;
+}
+
+} /* namespace bch */
+} /* namespace pocsag */
+
+#endif/*__POCSAG_BCH_H__*/
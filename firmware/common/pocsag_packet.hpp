@@ -32,6 +32,7 @@ namespace pocsag {
 
 enum BitRate : uint32_t {
 	UNKNOWN,
+	AUTO,				// Receive only: decode 512, 1200 and 2400bps at once
 	FSK512 = 512,
 	FSK1200 = 1200,
 	FSK2400 = 2400,
@@ -62,6 +63,33 @@ public:
 	uint32_t operator[](const size_t index) const {
 		return (index < 16) ? codewords[index] : 0;
 	}
+
+	// BCH correction outcome, one bit per codeword
+	void set_corrected(const size_t index) {
+		if (index < 16)
+			corrected_ |= (1 << index);
+	}
+
+	void set_failed(const size_t index) {
+		if (index < 16)
+			failed_ |= (1 << index);
+	}
+
+	bool corrected(const size_t index) const {
+		return (index < 16) ? ((corrected_ >> index) & 1) : false;
+	}
+
+	bool failed(const size_t index) const {
+		return (index < 16) ? ((failed_ >> index) & 1) : false;
+	}
+
+	uint16_t corrected_mask() const {
+		return corrected_;
+	}
+
+	uint16_t failed_mask() const {
+		return failed_;
+	}
 	
 	void set_bitrate(const BitRate bitrate) {
 		bitrate_ = bitrate;
@@ -83,11 +111,15 @@ public:
 		codewords.fill(0);
 		bitrate_ = UNKNOWN;
 		flag_ = NORMAL;
+		corrected_ = 0;
+		failed_ = 0;
 	}
 
 private:
 	BitRate bitrate_ { UNKNOWN };
 	PacketFlag flag_ { NORMAL };
+	uint16_t corrected_ { 0 };
+	uint16_t failed_ { 0 };
 	std::array <uint32_t, 16> codewords { 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0  };
 	Timestamp timestamp_ { };
 };
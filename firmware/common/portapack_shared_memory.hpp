@@ -46,18 +46,66 @@ struct ToneData {
 	uint8_t message[256];
 };
 
+/* Channel power measurement the M0 scanner requests right after a retune.
+ * The M4 answers by copying request_id to done_id once the window is measured.
+ */
+struct ScanMeasurement {
+	volatile uint32_t request_id;
+	volatile uint32_t done_id;
+	uint32_t settle_us;
+	uint32_t window_us;
+	volatile int32_t max_db;
+};
+
+struct ProfileCycles {
+	uint32_t min;
+	uint32_t avg;
+	uint32_t max;
+};
+
+/* Cycles per baseband block (one execute() call) spent in the stages the
+ * running processor marks with PROFILE_BEGIN/PROFILE_END. Published by the M4
+ * about once a second, the M0 only reads it.
+ */
+struct BasebandProfile {
+	enum class Stage : uint8_t {
+		Decimate = 0,
+		Filter,
+		Demod,
+		Audio,
+		Spectrum,
+	};
+	static constexpr size_t stage_count = 5;
+
+	volatile uint32_t update_count;
+	uint32_t block_count;
+	ProfileCycles block;
+	ProfileCycles stages[stage_count];
+};
+
 /* NOTE: These structures must be located in the same location in both M4 and M0 binaries */
 struct SharedMemory {
 	static constexpr size_t application_queue_k = 11;
 	static constexpr size_t app_local_queue_k = 11;
+	static constexpr size_t baseband_queue_k = 10;
 
 	uint8_t application_queue_data[1 << application_queue_k] { 0 };
 	uint8_t app_local_queue_data[1 << app_local_queue_k] { 0 };
-	const Message* volatile baseband_message { nullptr };
+	uint8_t baseband_queue_data[1 << baseband_queue_k] { 0 };
 	MessageQueue application_queue { application_queue_data, application_queue_k };
 	MessageQueue app_local_queue { app_local_queue_data, app_local_queue_k };
+	MessageQueue baseband_queue { baseband_queue_data, baseband_queue_k };
+
+	// M0 -> M4 completion tokens: messages pushed to baseband_queue so far,
+	// and messages the M4 is done with.
+	volatile uint32_t baseband_queued { 0 };
+	volatile uint32_t baseband_completed { 0 };
 
 	char m4_panic_msg[32] { 0 };
+
+	ScanMeasurement scan_measurement { 0, 0, 0, 0, 0 };
+
+	BasebandProfile baseband_profile { };
 	
 	union {
 		ToneData tones_data;
@@ -111,16 +111,45 @@ constexpr image_tag_t image_tag_noop				{ 'P', 'N', 'O', 'P' };
 
 constexpr image_tag_t image_tag_hackrf				{ 'H', 'R', 'F', '1' };
 
+/* First chunk in the images region, written by make_spi_image.py. Its data is
+ * an array of directory_entry_t, so looking up an image doesn't have to hop
+ * through every chunk in flash.
+ */
+constexpr image_tag_t image_tag_directory			{ 'P', 'D', 'I', 'R' };
+
 struct chunk_t {
 	const image_tag_t tag;
 	const uint32_t length;
 	const uint8_t data[];
 
+	/* Set in length when data holds a compressed_header_t followed by an
+	 * LZ4 block, instead of the raw image.
+	 */
+	static constexpr uint32_t flag_compressed = 0x80000000U;
+
+	size_t stored_length() const {
+		return length & ~flag_compressed;
+	}
+
+	bool is_compressed() const {
+		return length & flag_compressed;
+	}
+
 	const chunk_t* next() const {
-		return reinterpret_cast<const chunk_t*>(&data[length]);
+		return reinterpret_cast<const chunk_t*>(&data[stored_length()]);
 	}
 };
 
+struct compressed_header_t {
+	const uint32_t image_length;
+	const uint32_t block_length;
+};
+
+struct directory_entry_t {
+	const image_tag_t tag;
+	const uint32_t offset;			// From the start of the images region
+};
+
 struct region_t {
 	const size_t offset;
 	const size_t size;
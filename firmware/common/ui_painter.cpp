@@ -43,10 +43,18 @@ int Painter::draw_char(const Point p, const Style& style, const char c) {
 }
 
 int Painter::draw_string(Point p, const Font& font, const Color foreground,
-	const Color background, const std::string text) {
+	const Color background, const std::string_view text) {
+	
+	// Enough for a full screen width of the narrowest font
+	std::array<lcd::ILI9341::TextGlyph, 60> glyphs;
+	size_t count = 0;
+	Coord first_x = p.x();
+
+	// All glyphs of a font share the same size
+	const auto glyph_size = font.glyph(' ').size();
 	
 	bool escape = false;
-	size_t width = 0;
+	int width = 0;
 	Color pen = foreground;
 	
 	for(const auto c : text) {
@@ -60,18 +68,24 @@ int Painter::draw_string(Point p, const Font& font, const Color foreground,
 			if (c == '\x1B') {
 				escape = true;
 			} else {
-				const auto glyph = font.glyph(c);
-				display.draw_glyph(p, glyph, pen, background);
-				const auto advance = glyph.advance();
-				p += advance;
-				width += advance.x();
+				// Only glyphs entirely on screen are drawn
+				const Coord x = p.x() + width;
+				if( (x >= 0) && ((x + glyph_size.width()) <= display.width()) && (count < glyphs.size()) ) {
+					if( count == 0 ) {
+						first_x = x;
+					}
+					glyphs[count++] = { font.glyph(c).pixels(), pen };
+				}
+				width += glyph_size.width();
 			}
 		}
 	}
+
+	display.draw_glyphs({ first_x, p.y() }, glyph_size, glyphs.data(), count, background);
 	return width;
 }
 
-int Painter::draw_string(Point p, const Style& style, const std::string text) {
+int Painter::draw_string(Point p, const Style& style, const std::string_view text) {
 	return draw_string(p, style.font, style.foreground, style.background, text);
 }
 
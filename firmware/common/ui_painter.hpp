@@ -26,6 +26,7 @@
 #include "ui_text.hpp"
 
 #include <string>
+#include <string_view>
 
 namespace ui {
 
@@ -49,8 +50,8 @@ public:
 	int draw_char(const Point p, const Style& style, const char c);
 
 	int draw_string(Point p, const Font& font, const Color foreground,
-		const Color background, const std::string text);
-	int draw_string(Point p, const Style& style, const std::string text);
+		const Color background, const std::string_view text);
+	int draw_string(Point p, const Style& style, const std::string_view text);
 
 	void draw_bitmap(const Point p, const Bitmap& bitmap, const Color background, const Color foreground);
 
@@ -371,13 +371,26 @@ void Text::paint(Painter& painter) {
 	const auto rect = screen_rect();
 	const auto s = style();
 
-	painter.fill_rectangle(rect, s.background);
-
-	painter.draw_string(
+	const int text_width = painter.draw_string(
 		rect.location(),
 		s,
 		text
 	);
+
+	// Only clear what the glyphs didn't already paint over
+	const int text_height = std::min(s.font.line_height(), rect.height());
+	if( text_width < rect.width() ) {
+		painter.fill_rectangle(
+			{ rect.left() + text_width, rect.top(), rect.width() - text_width, text_height },
+			s.background
+		);
+	}
+	if( text_height < rect.height() ) {
+		painter.fill_rectangle(
+			{ rect.left(), rect.top() + text_height, rect.width(), rect.height() - text_height },
+			s.background
+		);
+	}
 }
 
 /* Labels ****************************************************************/
@@ -617,51 +630,84 @@ void Console::clear(bool clear_buffer = false) {
 	pos = { 0, 0 };
 }
 
-void Console::write(std::string message) {
+// Lines written while hidden are kept, up to 256 characters, for the next paint
+void Console::write(const std::string_view message) {
+	if (!hidden() && visible()) {
+		draw(message);
+		buffer = message;
+	} else {
+		if (buffer.size() < 256) buffer += message;
+	}
+}
+
+// Same as write() with a newline, without building a new string
+void Console::writeln(const std::string_view message) {
+	if (!hidden() && visible()) {
+		draw(message);
+		draw("\n");
+		buffer = message;
+		buffer += '\n';
+	} else {
+		if (buffer.size() < 256) {
+			buffer += message;
+			buffer += '\n';
+		}
+	}
+}
+
+void Console::draw(const std::string_view message) {
 	bool escape = false;
 	
-	if (!hidden() && visible()) {
-		const Style& s = style();
-		const Font& font = s.font;
-		const auto rect = screen_rect();
-		ui::Color pen_color = s.foreground;
-		
-		for (const auto c : message) {
-			if (escape) {
-				if (c <= 15)
-					pen_color = term_colors[(uint8_t)c];
-				else
-					pen_color = s.foreground;
-				escape = false;
+	const Style& s = style();
+	const Font& font = s.font;
+	const auto rect = screen_rect();
+	ui::Color pen_color = s.foreground;
+
+	// Glyphs are gathered per line and drawn through one LCD window
+	std::array<lcd::ILI9341::TextGlyph, 60> glyphs;
+	size_t count = 0;
+	Point line_start { };
+
+	const auto flush = [&]() {
+		display.draw_glyphs(line_start, font.glyph(' ').size(), glyphs.data(), count, s.background);
+		count = 0;
+	};
+	
+	for (const auto c : message) {
+		if (escape) {
+			if (c <= 15)
+				pen_color = term_colors[(uint8_t)c];
+			else
+				pen_color = s.foreground;
+			escape = false;
+		} else {
+			if (c == '\n') {
+				flush();
+				crlf();
+			} else if (c == '\x1B') {
+				escape = true;
 			} else {
-				if (c == '\n') {
+				const auto glyph = font.glyph(c);
+				const auto advance = glyph.advance();
+				if( (pos.x() + advance.x()) > rect.width() ) {
+					flush();
 					crlf();
-				} else if (c == '\x1B') {
-					escape = true;
-				} else {
-					const auto glyph = font.glyph(c);
-					const auto advance = glyph.advance();
-					if( (pos.x() + advance.x()) > rect.width() ) {
-						crlf();
-					}
-					const Point pos_glyph {
+				}
+				if( count == glyphs.size() ) {
+					flush();
+				}
+				if( count == 0 ) {
+					line_start = {
 						rect.left() + pos.x(),
 						display.scroll_area_y(pos.y())
 					};
-					display.draw_glyph(pos_glyph, glyph, pen_color, s.background);
-					pos += { advance.x(), 0 };
 				}
+				glyphs[count++] = { glyph.pixels(), pen_color };
+				pos += { advance.x(), 0 };
 			}
 		}
-		buffer = message;
-	} else {
-		if (buffer.size() < 256) buffer += message;
 	}
-}
-
-void Console::writeln(std::string message) {
-	write(message + "\n");
-	//crlf();
+	flush();
 }
 
 void Console::paint(Painter&) {
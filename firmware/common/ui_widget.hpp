@@ -37,6 +37,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace ui {
@@ -322,8 +323,8 @@ public:
 	Console(Rect parent_rect);
 	
 	void clear(bool clear_buffer);
-	void write(std::string message);
-	void writeln(std::string message);
+	void write(const std::string_view message);
+	void writeln(const std::string_view message);
 
 	void paint(Painter&) override;
 	
@@ -338,6 +339,7 @@ private:
 	static bool scrolling_enabled;
 
 	void crlf();
+	void draw(const std::string_view message);
 };
 
 class Checkbox : public Widget {
@@ -0,0 +1,154 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "test.hpp"
+
+#include "acars_format.hpp"
+#include "string_format.hpp"
+#include "crc.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+/* Formats decoded ACARS blocks the way acars_app.cpp does, checks the text
+ * against the std::string version it replaced, and counts heap allocations
+ * per block for both.
+ */
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+	allocations++;
+	if( void* const p = std::malloc(size ? size : 1) ) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	std::free(p);
+}
+
+static uint8_t with_parity(const char c) {
+	const uint8_t v = c & 0x7F;
+	return (__builtin_popcount(v) & 1) ? v : (v | 0x80);
+}
+
+// SOH, then mode to ETX as given, then the BCS
+static baseband::Packet make_block(const std::string& characters) {
+	std::vector<uint8_t> body;
+	for(const auto c : characters) {
+		body.push_back(with_parity(c));
+	}
+	body.push_back(with_parity(0x03));
+
+	CRC<16, true, true> bcs { 0x1021, 0x0000, 0x0000 };
+	for(const auto c : body) {
+		bcs.process_byte(c);
+	}
+	body.push_back(bcs.checksum() & 0xFF);
+	body.push_back(bcs.checksum() >> 8);
+	body.insert(body.begin(), with_parity(0x01));
+
+	baseband::Packet packet;
+	packet.set_timestamp({ 2024, 5, 6, 12, 34, 56 });
+	for(const auto c : body) {
+		for(size_t i=0; i<8; i++) {
+			packet.add((c >> i) & 1);
+		}
+	}
+	return packet;
+}
+
+// What acars_app.cpp did before format_into
+static std::string old_console_line(const acars::Packet& packet, const uint32_t f) {
+	std::string console_info;
+	console_info = to_string_datetime(packet.received_at(), HMS);
+	console_info += " " + (to_string_dec_uint(f / 1000000) + "." + to_string_dec_uint((f / 1000) % 1000, 3, '0'));
+	console_info += " " + packet.registration_number();
+	console_info += " " + packet.label();
+	console_info += " #" + std::string(1, packet.block_id());
+	return console_info;
+}
+
+static std::string old_log_entry(const acars::Packet& packet, const uint32_t frequency) {
+	std::string entry = "F:" + to_string_dec_uint(frequency) + "Hz";
+	entry.reserve(64 + packet.length() / 8);
+
+	entry += " M:" + std::string(1, packet.mode());
+	entry += " R:" + packet.registration_number();
+	entry += " L:" + packet.label();
+	entry += " B:" + std::string(1, packet.block_id());
+	entry += " " + packet.message_text();
+	return entry;
+}
+
+int main() {
+	const std::vector<acars::Packet> packets {
+		{ make_block("2.N12345\x15H11\x02#M1BPOSN52123W001234,,123456,350,,,,,M45,12345,123,P1") },
+		{ make_block("2.N12345\x15_d1") },
+		{ make_block("2.G-ABCD\x15" "5Z3\x02" + std::string(200, 'X') + "\x7F\x01") },
+	};
+	const uint32_t frequency = 131525000;
+
+	for(const auto& packet : packets) {
+		CHECK(packet.is_valid());
+
+		FixedString<40> console_info;
+		acars::format::console_line(console_info, packet, frequency);
+		CHECK(std::string_view { console_info } == old_console_line(packet, frequency));
+
+		FixedString<272> entry;
+		acars::format::log_entry(entry, packet, frequency);
+		CHECK(std::string_view { entry } == old_log_entry(packet, frequency));
+	}
+
+	constexpr size_t rounds = 1000;
+	size_t old_count = 0;
+	size_t new_count = 0;
+
+	for(size_t i=0; i<rounds; i++) {
+		for(const auto& packet : packets) {
+			allocations = 0;
+			const auto console_info = old_console_line(packet, frequency);
+			const auto entry = old_log_entry(packet, frequency);
+			old_count += allocations;
+
+			allocations = 0;
+			FixedString<40> new_console_info;
+			acars::format::console_line(new_console_info, packet, frequency);
+			FixedString<272> new_entry;
+			acars::format::log_entry(new_entry, packet, frequency);
+			new_count += allocations;
+		}
+	}
+
+	const size_t blocks = rounds * packets.size();
+	std::printf("allocations per block: std::string %.1f, format_into %.1f\n",
+		double(old_count) / blocks, double(new_count) / blocks);
+	CHECK(new_count == 0);
+
+	return test_result();
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "test.hpp"
+
+#include "dsp_fir_taps.hpp"
+
+#include <cmath>
+#include <complex>
+
+/* Response of the ACARS channel chain (614.4kHz -> 76.8kHz -> 38.4kHz) as
+ * quantized in dsp_fir_taps.hpp, relative to DC. Offsets are from the channel
+ * center; the 614.4kHz input spans +/-307.2kHz around it.
+ */
+
+static constexpr double fs_1 = 614400.0;
+static constexpr double fs_2 = fs_1 / 8;
+static constexpr double fs_out = fs_2 / 2;
+
+template<typename T>
+static double tap_value(const T& tap) {
+	return tap;
+}
+
+static double tap_value(const complex16_t& tap) {
+	return tap.real();
+}
+
+template<typename Taps>
+static double gain(const Taps& taps, const double f, const double fs) {
+	std::complex<double> sum { };
+	double dc { 0 };
+	for(size_t i=0; i<taps.size(); i++) {
+		const double t = tap_value(taps[i]);
+		sum += t * std::polar(1.0, -2.0 * M_PI * f / fs * i);
+		dc += t;
+	}
+	return std::abs(sum) / dc;
+}
+
+static double response_db(const double f) {
+	// Stage 2 sees everything folded into +/-38.4kHz by the first decimation
+	const double f_2 = std::remainder(f, fs_2);
+	const double g = gain(taps_acars_decim_1.taps, f, fs_1) * gain(taps_acars_decim_2.taps, f_2, fs_2);
+	return 20.0 * std::log10(g);
+}
+
+int main() {
+	// Stage 2 taps are real, the I/Q paths must see the same filter
+	for(const auto& tap : taps_acars_decim_2.taps) {
+		CHECK(tap.imag() == 0);
+	}
+
+	// MSK at 2400 baud sits well inside 5kHz
+	double pass_db { 0 };
+	for(double f=0; f<=5000; f+=50) {
+		pass_db = std::min(pass_db, response_db(f));
+	}
+	std::printf("passband 0-5kHz: %.2f dB\n", pass_db);
+	CHECK(pass_db > -0.5);
+
+	double stop_db { -1000 };
+	for(double f=12500; f<=25000; f+=25) {
+		stop_db = std::max(stop_db, response_db(f));
+	}
+	std::printf("stopband 12.5-25kHz: %.1f dB\n", stop_db);
+	CHECK(stop_db < -40.0);
+
+	// Whatever lands within +/-5kHz after both decimations
+	double alias_db { -1000 };
+	for(double f=12500; f<=fs_1 / 2; f+=25) {
+		if( std::abs(std::remainder(f, fs_out)) <= 5000 ) {
+			alias_db = std::max(alias_db, response_db(f));
+		}
+	}
+	std::printf("aliases into 0-5kHz: %.1f dB\n", alias_db);
+	CHECK(alias_db < -40.0);
+
+	return test_result();
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "test.hpp"
+
+#include "hdlc_deframer.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using Frame = std::vector<uint8_t>;
+
+/* AX.25 line bitstreams as the AFSK slicers hand them over: NRZI, one line
+ * bit per bit, first bit in the LSB of each byte. They were produced by a
+ * reference AX.25 encoder (bit stuffing, X.25 FCS) from the frames below,
+ * which include their FCS as the deframer leaves it.
+ */
+static const uint8_t frame_position[] {
+	0x82, 0xa0, 0xa4, 0xa6, 0x40, 0x40, 0x60, 0x9c, 0x60, 0x86, 0x82, 0x98,
+	0x98, 0x6e, 0xae, 0x92, 0x88, 0x8a, 0x62, 0x40, 0x63, 0x03, 0xf0, 0x21,
+	0x34, 0x39, 0x30, 0x33, 0x2e, 0x35, 0x30, 0x4e, 0x2f, 0x30, 0x37, 0x32,
+	0x30, 0x31, 0x2e, 0x37, 0x35, 0x57, 0x2d, 0x54, 0x65, 0x73, 0x74, 0xbf,
+	0x88,
+};
+static const uint8_t frame_stuffing[] {
+	0x82, 0xa0, 0xa4, 0xa6, 0x40, 0x40, 0x60, 0x9c, 0x60, 0x86, 0x82, 0x98,
+	0x98, 0x72, 0xae, 0x92, 0x88, 0x8a, 0x62, 0x40, 0x62, 0xae, 0x92, 0x88,
+	0x8a, 0x64, 0x40, 0x63, 0x03, 0xf0, 0x3e, 0x7e, 0x7e, 0x3f, 0x3f, 0x20,
+	0x73, 0x74, 0x75, 0x66, 0x66, 0x69, 0x6e, 0x67, 0x20, 0x63, 0x68, 0x65,
+	0x63, 0x6b, 0x20, 0x7e, 0x7e, 0xef, 0x74,
+};
+static const uint8_t frame_message[] {
+	0x82, 0xa0, 0xb4, 0x60, 0x60, 0x62, 0x60, 0x9c, 0x62, 0xa8, 0x8a, 0xa6,
+	0xa8, 0x61, 0x03, 0xf0, 0x3a, 0x4e, 0x30, 0x43, 0x41, 0x4c, 0x4c, 0x20,
+	0x20, 0x20, 0x3a, 0x61, 0x63, 0x6b, 0x34, 0x32, 0x2a, 0x7f,
+};
+// Four flags, frame_position, two flags
+static const uint8_t stream_single[] {
+	0x01, 0x01, 0x01, 0x01, 0xa9, 0x95, 0x6d, 0x6e, 0x2a, 0xd5, 0xea, 0x42,
+	0xea, 0xae, 0xa9, 0x45, 0xba, 0xe1, 0x9e, 0x49, 0x5a, 0xa6, 0xe9, 0x2a,
+	0x17, 0x57, 0xf5, 0x2b, 0xe5, 0xf6, 0xea, 0xee, 0xc2, 0xe6, 0xea, 0x42,
+	0x3e, 0x15, 0xe1, 0x12, 0x15, 0xe9, 0xc2, 0x1e, 0x19, 0x61, 0xc6, 0x9a,
+	0xd9, 0x11, 0x1a, 0x7e, 0x96, 0x06, 0x04, 0xfc,
+};
+// frame_position, frame_stuffing and frame_message, one flag between each
+static const uint8_t stream_shared_flags[] {
+	0xfe, 0xfe, 0xfe, 0x56, 0x6a, 0x92, 0x91, 0xd5, 0x2a, 0x15, 0xbd, 0x15,
+	0x51, 0x56, 0xba, 0x45, 0x1e, 0x61, 0xb6, 0xa5, 0x59, 0x16, 0xd5, 0xe8,
+	0xa8, 0x0a, 0xd4, 0x1a, 0x09, 0x15, 0x11, 0x3d, 0x19, 0x15, 0xbd, 0xc1,
+	0xea, 0x1e, 0xed, 0xea, 0x16, 0x3d, 0xe1, 0xe6, 0x9e, 0x39, 0x65, 0x26,
+	0xee, 0xe5, 0x81, 0x69, 0xf9, 0x5b, 0xa9, 0x49, 0x46, 0x56, 0xab, 0x54,
+	0xf4, 0x56, 0x44, 0x59, 0xe9, 0x16, 0xd9, 0x7b, 0x26, 0x69, 0x99, 0xa6,
+	0xab, 0xa4, 0x7b, 0x26, 0x69, 0x99, 0xb6, 0xab, 0x5c, 0x5c, 0xd5, 0x07,
+	0x0a, 0xec, 0xe7, 0x27, 0xb0, 0x4a, 0x84, 0x86, 0x79, 0x77, 0x77, 0x72,
+	0x8f, 0x77, 0xb5, 0x8b, 0x72, 0x76, 0x74, 0x8c, 0x4a, 0x3f, 0x81, 0xc1,
+	0x1b, 0x02, 0x52, 0x2b, 0x1b, 0x2b, 0x2a, 0xd2, 0xd5, 0x85, 0x2c, 0xca,
+	0x4c, 0x23, 0xcb, 0x28, 0xae, 0xea, 0xf3, 0x42, 0xea, 0xae, 0xa9, 0x45,
+	0xba, 0xd5, 0x2a, 0xd5, 0xf2, 0xd6, 0xd1, 0x31, 0x1a, 0xed, 0x32, 0x81,
+	0xfb, 0xfb, 0x03,
+};
+// frame_stuffing aborted after 200 bits, then frame_message
+static const uint8_t stream_abort[] {
+	0x01, 0x01, 0x01, 0xa9, 0x95, 0x6d, 0x6e, 0x2a, 0xd5, 0xea, 0x42, 0xea,
+	0xae, 0xa9, 0x45, 0xba, 0x09, 0x61, 0xb6, 0xa5, 0x59, 0x16, 0xd5, 0x16,
+	0x61, 0xb6, 0xa5, 0x59, 0x00, 0xfe, 0xfe, 0x56, 0x6a, 0x72, 0xea, 0xea,
+	0x16, 0x15, 0xbd, 0xe9, 0x9a, 0x59, 0x6e, 0x9a, 0xeb, 0xa8, 0x0a, 0x86,
+	0xde, 0x8a, 0x28, 0x2b, 0xdd, 0x22, 0x95, 0x6a, 0x95, 0x86, 0x14, 0x17,
+	0xe7, 0x72, 0x89, 0x66, 0x3f, 0x02, 0x02, 0xfe,
+};
+// frame_position with bit 100 flipped, then frame_message
+static const uint8_t stream_bad_fcs[] {
+	0xfe, 0xfe, 0xfe, 0x56, 0x6a, 0x92, 0x91, 0xd5, 0x2a, 0x15, 0xbd, 0x15,
+	0x51, 0x56, 0xba, 0xa5, 0xe1, 0x9e, 0x49, 0x5a, 0xa6, 0xe9, 0x2a, 0x17,
+	0x57, 0xf5, 0x2b, 0xe5, 0xf6, 0xea, 0xee, 0xc2, 0xe6, 0xea, 0x42, 0x3e,
+	0x15, 0xe1, 0x12, 0x15, 0xe9, 0xc2, 0x1e, 0x19, 0x61, 0xc6, 0x9a, 0xd9,
+	0x11, 0x1a, 0x7e, 0x96, 0x06, 0xa4, 0x56, 0x36, 0x56, 0x54, 0xa4, 0xab,
+	0x0b, 0x59, 0x94, 0x99, 0x46, 0x96, 0x51, 0x5c, 0xd5, 0xe7, 0x85, 0xd4,
+	0x5d, 0x53, 0x8b, 0x74, 0xab, 0x55, 0xaa, 0xe5, 0xad, 0xa3, 0x63, 0x34,
+	0xda, 0x65, 0x02, 0xf7, 0xf7, 0x07,
+};
+
+template<size_t N>
+static Frame frame(const uint8_t (&bytes)[N]) {
+	return Frame(bytes, bytes + N);
+}
+
+template<size_t N>
+static std::vector<Frame> deframe_bits(const uint8_t (&stream)[N]) {
+	hdlc::Deframer deframer;
+	std::vector<Frame> frames;
+	for(const auto byte : stream) {
+		for(size_t i=0; i<8; i++) {
+			if( deframer.execute((byte >> i) & 1) ) {
+				frames.emplace_back(deframer.data(), deframer.data() + deframer.size());
+			}
+		}
+	}
+	return frames;
+}
+
+template<size_t N>
+static std::vector<Frame> deframe_bytes(const uint8_t (&stream)[N]) {
+	hdlc::Deframer deframer;
+	std::vector<Frame> frames;
+	for(const auto byte : stream) {
+		if( deframer.execute_byte(byte) ) {
+			frames.emplace_back(deframer.data(), deframer.data() + deframer.size());
+		}
+	}
+	return frames;
+}
+
+template<size_t N>
+static void check_stream(const uint8_t (&stream)[N], const std::vector<Frame>& expected) {
+	CHECK(deframe_bits(stream) == expected);
+	CHECK(deframe_bytes(stream) == expected);
+}
+
+static void test_fcs() {
+	// CRC-16/X.25 check value
+	uint16_t fcs = hdlc::fcs_init;
+	for(const auto c : { '1', '2', '3', '4', '5', '6', '7', '8', '9' }) {
+		fcs = hdlc::fcs_update(fcs, c);
+	}
+	CHECK((fcs ^ 0xFFFF) == 0x906E);
+
+	// Frame plus its FCS leaves the residue
+	fcs = hdlc::fcs_init;
+	for(const auto byte : frame_position) {
+		fcs = hdlc::fcs_update(fcs, byte);
+	}
+	CHECK(fcs == hdlc::fcs_residue);
+}
+
+static void test_streams() {
+	check_stream(stream_single, { frame(frame_position) });
+	check_stream(stream_shared_flags, { frame(frame_position), frame(frame_stuffing), frame(frame_message) });
+	check_stream(stream_abort, { frame(frame_message) });
+	check_stream(stream_bad_fcs, { frame(frame_message) });
+}
+
+static void test_noise() {
+	// Random line bits: the FCS has to keep everything out
+	std::mt19937 rng { 1 };
+	hdlc::Deframer deframer;
+	size_t frames = 0;
+	for(size_t i=0; i<1000000; i++) {
+		frames += deframer.execute_byte(rng() & 0xFF) ? 1 : 0;
+	}
+	CHECK(frames == 0);
+}
+
+int main() {
+	test_fcs();
+	test_streams();
+	test_noise();
+	return test_result();
+}
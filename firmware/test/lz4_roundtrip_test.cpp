@@ -0,0 +1,198 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "test.hpp"
+
+#include "lz4.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Packs images with tools/make_spi_image.py --compress and unpacks them the
+ * way core_control.cpp does, with lz4::decompress_block. Chunk layout as in
+ * spi_image.hpp, which can't be included off target.
+ *
+ * Usage: lz4_roundtrip_test <python> <make_spi_image.py> <work dir>
+ */
+
+using bytes_t = std::vector<uint8_t>;
+
+struct Image {
+	char tag[4];
+	bytes_t data;
+};
+
+static constexpr uint32_t flag_compressed = 0x80000000U;
+
+static uint32_t read_u32(const bytes_t& data, const size_t offset) {
+	uint32_t value;
+	std::memcpy(&value, &data[offset], sizeof(value));
+	return value;
+}
+
+static void append_u32(bytes_t& data, const uint32_t value) {
+	const auto p = reinterpret_cast<const uint8_t*>(&value);
+	data.insert(data.end(), p, p + sizeof(value));
+}
+
+static void write_file(const std::string& path, const bytes_t& data) {
+	std::ofstream f { path, std::ios::binary };
+	f.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+static bytes_t read_file(const std::string& path) {
+	std::ifstream f { path, std::ios::binary };
+	return { std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>() };
+}
+
+// Something like code: a small vocabulary of words, so matches are common
+static bytes_t make_code(std::mt19937& rng, const size_t length) {
+	std::vector<uint32_t> words(64);
+	for(auto& word : words) {
+		word = rng();
+	}
+	bytes_t data;
+	while( data.size() < length ) {
+		append_u32(data, words[rng() % words.size()]);
+		if( (rng() % 8) == 0 ) {
+			// Literal runs past 15 and 270 bytes take extra length bytes
+			const size_t run = rng() % 300;
+			for(size_t i=0; i<run; i++) {
+				data.push_back(rng());
+			}
+		}
+	}
+	data.resize(length);
+	return data;
+}
+
+// Long runs of one byte: overlapping matches at offset 1, lengths past 270
+static bytes_t make_runs(std::mt19937& rng, const size_t length) {
+	bytes_t data;
+	while( data.size() < length ) {
+		data.insert(data.end(), 1 + rng() % 1000, rng());
+	}
+	data.resize(length);
+	return data;
+}
+
+static bytes_t make_noise(std::mt19937& rng, const size_t length) {
+	bytes_t data(length);
+	for(auto& b : data) {
+		b = rng();
+	}
+	return data;
+}
+
+int main(int argc, char** argv) {
+	if( argc != 4 ) {
+		std::printf("usage: %s <python> <make_spi_image.py> <work dir>\n", argv[0]);
+		return 1;
+	}
+	const std::string dir { argv[3] };
+
+	// make_image_chunk.py only takes images that are a multiple of four bytes
+	std::mt19937 rng { 1 };
+	const std::vector<Image> images {
+		{ { 'P', 'C', 'O', 'D' }, make_code(rng, 32768) },
+		{ { 'P', 'R', 'U', 'N' }, make_runs(rng, 32768) },
+		{ { 'P', 'N', 'O', 'I' }, make_noise(rng, 4096) },
+		{ { 'P', 'S', 'M', 'L' }, bytes_t(12, 0x55) },
+		{ { 'P', 'O', 'D', 'D' }, make_code(rng, 1000) },
+	};
+
+	// Chunks as baseband/CMakeLists.txt concatenates them, then a null tag
+	bytes_t baseband;
+	for(const auto& image : images) {
+		baseband.insert(baseband.end(), image.tag, image.tag + 4);
+		append_u32(baseband, image.data.size());
+		baseband.insert(baseband.end(), image.data.begin(), image.data.end());
+	}
+	baseband.insert(baseband.end(), 8, 0);
+
+	const bytes_t application(1024, 0xAA);
+	write_file(dir + "/application.bin", application);
+	write_file(dir + "/baseband.bin", baseband);
+
+	const std::string command =
+		std::string(argv[1]) + " " + argv[2] + " --compress " +
+		dir + "/application.bin " + dir + "/baseband.bin " + dir + "/spi.bin";
+	CHECK(std::system(command.c_str()) == 0);
+
+	const auto spi = read_file(dir + "/spi.bin");
+	CHECK(spi.size() > application.size() + 8);
+	if( spi.size() <= application.size() + 8 ) {
+		return test_result();
+	}
+	const bytes_t region { spi.begin() + application.size(), spi.end() };
+
+	CHECK(std::memcmp(&region[0], "PDIR", 4) == 0);
+	const size_t entry_count = read_u32(region, 4) / 8;
+	CHECK(entry_count == images.size());
+
+	for(size_t i=0; i<entry_count; i++) {
+		const auto& image = images[i];
+		const size_t entry = 8 + i * 8;
+		const size_t chunk = read_u32(region, entry + 4);
+
+		CHECK(std::memcmp(&region[entry], image.tag, 4) == 0);
+		CHECK(std::memcmp(&region[chunk], image.tag, 4) == 0);
+		// M0 loads chunk headers as words
+		CHECK((chunk & 3) == 0);
+
+		const uint32_t length = read_u32(region, chunk + 4);
+		const auto data = &region[chunk + 8];
+		bytes_t out(32768);
+		size_t out_length;
+
+		if( length & flag_compressed ) {
+			const uint32_t image_length = read_u32(region, chunk + 8);
+			const uint32_t block_length = read_u32(region, chunk + 12);
+			CHECK((block_length + 8) <= (length & ~flag_compressed));
+			out_length = lz4::decompress_block(data + 8, block_length, out.data(), out.size());
+			CHECK(out_length == image_length);
+
+			// A block cut short or a destination too small is refused
+			bytes_t scratch(out.size());
+			CHECK(lz4::decompress_block(data + 8, block_length / 2, scratch.data(), scratch.size()) != image_length);
+			CHECK(lz4::decompress_block(data + 8, block_length, scratch.data(), image_length - 1) == 0);
+		} else {
+			out_length = length;
+			std::memcpy(out.data(), data, length);
+		}
+
+		CHECK(out_length == image.data.size());
+		CHECK(std::equal(image.data.begin(), image.data.end(), out.begin()));
+		std::printf("%.4s %5zu -> %5u%s\n", image.tag, image.data.size(), length & ~flag_compressed,
+			(length & flag_compressed) ? " lz4" : "");
+	}
+
+	// Noise doesn't shrink and is stored as is, the rest should compress
+	CHECK(read_u32(region, read_u32(region, 8 + 0 * 8 + 4) + 4) & flag_compressed);
+	CHECK(read_u32(region, read_u32(region, 8 + 1 * 8 + 4) + 4) & flag_compressed);
+	CHECK(!(read_u32(region, read_u32(region, 8 + 2 * 8 + 4) + 4) & flag_compressed));
+
+	return test_result();
+}
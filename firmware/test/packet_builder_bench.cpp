@@ -0,0 +1,106 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "packet_builder.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <chrono>
+#include <random>
+#include <vector>
+
+Timestamp Timestamp::now() {
+	return { };
+}
+
+/* Host timing of PacketBuilder with each sync matcher, over noise only (the
+ * preamble search, where a decoder spends nearly all of its symbols) and over
+ * noise with TPMS-like frames every 400 symbols (payload collection and the
+ * handler as well). Absolute figures mean little for the M4 (no 64-bit
+ * popcount there), the ratios are what to look at.
+ */
+
+constexpr uint32_t sync_word = 0b01010101010101010101010101100101;
+constexpr size_t payload_length = 76 * 2;
+
+class Sink {
+public:
+	size_t count { 0 };
+	baseband::Packet last { };
+
+	// Copies the packet, as building the packet message would
+	void on_packet(const baseband::Packet& packet) {
+		last = packet;
+		count++;
+	}
+};
+
+using SinkHandler = PacketHandler<Sink, &Sink::on_packet>;
+
+template<typename Matcher>
+static void run(const char* const name, const std::vector<uint8_t>& symbols) {
+	Sink sink;
+	PacketBuilder<Matcher, NeverMatch, FixedLength, SinkHandler> builder {
+		{ sync_word, 32, 1 },
+		{ },
+		{ payload_length },
+		{ &sink }
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+	for(const auto symbol : symbols) {
+		builder.execute(symbol);
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	std::printf("  %-10s %6.2f ns/symbol (%zu packets)\n", name, ns / symbols.size(), sink.count);
+}
+
+int main() {
+	constexpr size_t symbol_count = 20000000;
+	constexpr size_t frame_spacing = 400;
+
+	std::mt19937 rng { 1 };
+	std::vector<uint8_t> noise(symbol_count);
+	for(auto& symbol : noise) {
+		symbol = rng() & 1;
+	}
+
+	// Sync word and random payload written over the noise
+	auto framed = noise;
+	size_t frames = 0;
+	for(size_t start=0; start + 32 + payload_length <= framed.size(); start += frame_spacing) {
+		for(size_t n=0; n<32; n++) {
+			framed[start + n] = (sync_word >> (31 - n)) & 1;
+		}
+		frames++;
+	}
+
+	for(size_t pass=0; pass<2; pass++) {
+		std::printf("Noise only\n");
+		run<BitPattern>("BitPattern", noise);
+		run<SyncWord>("SyncWord", noise);
+		std::printf("%zu frames in noise\n", frames);
+		run<BitPattern>("BitPattern", framed);
+		run<SyncWord>("SyncWord", framed);
+	}
+	return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "test.hpp"
+
+#include "packet_builder.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+Timestamp Timestamp::now() {
+	return { };
+}
+
+class Sink {
+public:
+	std::vector<std::vector<uint8_t>> packets { };
+
+	void on_packet(const baseband::Packet& packet) {
+		std::vector<uint8_t> bits;
+		for(size_t i=0; i<packet.size(); i++) {
+			bits.push_back(packet[i]);
+		}
+		packets.push_back(bits);
+	}
+};
+
+using SinkHandler = PacketHandler<Sink, &Sink::on_packet>;
+
+static BitHistory history_of(const uint64_t bits, const size_t count) {
+	BitHistory history;
+	for(size_t n=count; n>0; n--) {
+		history.add((bits >> (n - 1)) & 1);
+	}
+	return history;
+}
+
+static void test_sync_word_tolerance() {
+	const uint32_t code = 0b01010110010110100101101001101010;
+	const SyncWord exact { code, 32, 0 };
+	const SyncWord tolerant { code, 32, 1 };
+
+	CHECK(exact(history_of(code, 32), 0));
+	CHECK(!exact(history_of(code ^ 0x100, 32), 0));
+	CHECK(tolerant(history_of(code ^ 0x100, 32), 0));
+	CHECK(!tolerant(history_of(code ^ 0x101, 32), 0));
+
+	// Bits older than the pattern don't count
+	const SyncWord short_word { 0b0101010101111110, 16, 0 };
+	CHECK(short_word(history_of(0xFFFF557EULL, 32), 0));
+	CHECK(short_word(history_of(0xABCD557EULL, 32), 0));
+	CHECK(!short_word(history_of(0xABCD557FULL, 32), 0));
+}
+
+static void test_sync_word_matches_bit_pattern() {
+	// SyncWord replaced BitPattern for patterns up to 32 bits, they must agree
+	std::mt19937 rng { 1 };
+	for(size_t trial=0; trial<20000; trial++) {
+		const size_t length = 1 + rng() % 32;
+		const uint32_t code = rng();
+		const size_t distance = rng() % 3;
+		const SyncWord sync { code, length, distance };
+		const BitPattern pattern { code, length, distance };
+
+		// Mostly near misses, random histories would hardly ever match
+		uint64_t bits = (static_cast<uint64_t>(rng()) << 32) | code;
+		for(size_t flips=rng() % 4; flips>0; flips--) {
+			bits ^= 1ULL << (rng() % length);
+		}
+		const auto history = history_of(bits, 64);
+		CHECK(sync(history, 0) == pattern(history, 0));
+	}
+}
+
+static void test_fixed_length_packet() {
+	// ERT SCM: Manchester preamble and sync, then a fixed number of symbols
+	const uint64_t preamble = 0b101010101001011001100110010110100101010101;
+	const uint32_t sync = static_cast<uint32_t>(preamble);
+
+	Sink sink;
+	PacketBuilder<SyncWord, NeverMatch, FixedLength, SinkHandler> builder {
+		{ sync, 32, 1 },
+		{ },
+		{ 150 },
+		{ &sink }
+	};
+
+	std::mt19937 rng { 2 };
+	std::vector<uint8_t> payload(150);
+	for(auto& bit : payload) {
+		bit = rng() & 1;
+	}
+
+	// Noise, the preamble with one bit in error, the payload, more noise
+	for(size_t i=0; i<100; i++) {
+		builder.execute(0);
+	}
+	for(size_t n=42; n>0; n--) {
+		builder.execute(((preamble ^ (1ULL << 7)) >> (n - 1)) & 1);
+	}
+	for(const auto bit : payload) {
+		builder.execute(bit);
+	}
+	for(size_t i=0; i<100; i++) {
+		builder.execute(0);
+	}
+
+	CHECK(sink.packets.size() == 1);
+	if( sink.packets.size() == 1 ) {
+		CHECK(sink.packets[0] == payload);
+	}
+}
+
+static void test_unstuffed_packet() {
+	// AIS: flag, bit stuffing, closing flag
+	Sink sink;
+	PacketBuilder<SyncWord, SyncWord, SyncWord, SinkHandler> builder {
+		{ 0b0101010101111110, 16, 1 },
+		{ 0b111110, 6 },
+		{ 0b01111110, 8 },
+		{ &sink }
+	};
+
+	const std::vector<uint8_t> payload { 1,1,1,1,1,1,1,0, 0,1,1,0,1,0,1,1 };
+	std::vector<uint8_t> line { 0,1,0,1,0,1,0,1, 0,1,1,1,1,1,1,0 };
+	size_t ones = 0;
+	for(const auto bit : payload) {
+		line.push_back(bit);
+		ones = bit ? ones + 1 : 0;
+		if( ones == 5 ) {
+			line.push_back(0);
+			ones = 0;
+		}
+	}
+	for(const auto bit : { 0,1,1,1,1,1,1,0 }) {
+		line.push_back(bit);
+	}
+
+	for(const auto bit : line) {
+		builder.execute(bit);
+	}
+
+	// The closing flag's leading bits are part of the packet, as before
+	CHECK(sink.packets.size() == 1);
+	if( sink.packets.size() == 1 ) {
+		const auto& bits = sink.packets[0];
+		CHECK(bits.size() >= payload.size());
+		CHECK(std::vector<uint8_t>(bits.begin(), bits.begin() + payload.size()) == payload);
+	}
+}
+
+int main() {
+	test_sync_word_tolerance();
+	test_sync_word_matches_bit_pattern();
+	test_fixed_length_packet();
+	test_unstuffed_packet();
+	return test_result();
+}
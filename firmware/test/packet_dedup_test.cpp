@@ -0,0 +1,137 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "test.hpp"
+
+#include "packet_dedup.hpp"
+
+#include <vector>
+
+/* PacketDedup against a settable system time: the window edge, the 32-bit
+ * tick counter wrapping, and which slot gives way when a probe run is full.
+ */
+
+systime_t host_system_time = 0;
+
+// Keys that all start probing from the same slot
+static uint32_t colliding_key(const size_t n) {
+	return 7 + n * 32;
+}
+
+static void window() {
+	PacketDedup dedup { 1000 };
+	host_system_time = 5000;
+
+	CHECK(!dedup.is_repeat(0x1234));
+	host_system_time += 999;
+	CHECK(dedup.is_repeat(0x1234));
+
+	// Repeats don't refresh the slot, so it lapses a window after first sight
+	host_system_time += 1;
+	CHECK(!dedup.is_repeat(0x1234));
+	host_system_time += 500;
+	CHECK(dedup.is_repeat(0x1234));
+}
+
+static void disabled() {
+	PacketDedup dedup { 0 };
+	host_system_time = 5000;
+
+	CHECK(!dedup.is_repeat(0x1234));
+	CHECK(!dedup.is_repeat(0x1234));
+}
+
+static void wrap() {
+	PacketDedup dedup { 1000 };
+	host_system_time = 0xffffffff - 200;
+
+	CHECK(!dedup.is_repeat(0x1234));
+	host_system_time += 500;
+	CHECK(host_system_time < 1000);
+	CHECK(dedup.is_repeat(0x1234));
+	host_system_time += 500;
+	CHECK(!dedup.is_repeat(0x1234));
+}
+
+static void eviction() {
+	PacketDedup dedup { 1000 };
+	host_system_time = 10000;
+
+	// Fill the four slots the colliding keys probe, oldest first
+	for(size_t i=0; i<4; i++) {
+		CHECK(!dedup.is_repeat(colliding_key(i)));
+		host_system_time += 100;
+	}
+	for(size_t i=0; i<4; i++) {
+		CHECK(dedup.is_repeat(colliding_key(i)));
+	}
+
+	// A fifth takes the oldest slot
+	CHECK(!dedup.is_repeat(colliding_key(4)));
+	CHECK(!dedup.is_repeat(colliding_key(0)));
+
+	// ... which then evicted key 1, leaving 2, 3 and 4
+	CHECK(dedup.is_repeat(colliding_key(2)));
+	CHECK(dedup.is_repeat(colliding_key(3)));
+	CHECK(dedup.is_repeat(colliding_key(4)));
+	CHECK(!dedup.is_repeat(colliding_key(1)));
+
+	// Expired slots are reused before any live one
+	host_system_time += 950;
+	CHECK(!dedup.is_repeat(colliding_key(5)));
+	CHECK(dedup.is_repeat(colliding_key(1)));
+
+	// Keys from other slots are left alone throughout
+	PacketDedup other { 1000 };
+	CHECK(!other.is_repeat(colliding_key(0)));
+	for(size_t i=0; i<8; i++) {
+		CHECK(!other.is_repeat(colliding_key(0) + 8 + i));
+	}
+	CHECK(other.is_repeat(colliding_key(0)));
+}
+
+static void keys() {
+	const std::vector<uint8_t> a { 0x01, 0x02, 0x03, 0x04 };
+	const std::vector<uint8_t> b { 0x01, 0x02, 0x03, 0x05 };
+	CHECK(PacketDedup::key(a.data(), a.size()) != PacketDedup::key(b.data(), b.size()));
+
+	// CRC-32/IEEE of "123456789"
+	const uint8_t check[] { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	CHECK(PacketDedup::key(check, sizeof(check)) == 0xcbf43926);
+
+	// Bit packets that differ only in trailing zeroes get different keys
+	baseband::Packet short_packet;
+	baseband::Packet long_packet;
+	for(size_t i=0; i<16; i++) {
+		short_packet.add(i & 1);
+		long_packet.add(i & 1);
+	}
+	long_packet.add(0);
+	CHECK(PacketDedup::key(short_packet) != PacketDedup::key(long_packet));
+}
+
+int main() {
+	window();
+	disabled();
+	wrap();
+	eviction();
+	keys();
+
+	return test_result();
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _CH_H_
+#define _CH_H_
+
+#include <cstdint>
+
+/* The slice of the ChibiOS kernel API application code under test uses. The
+ * system time is a plain variable the tests set, ticking at the application's
+ * CH_FREQUENCY of 1kHz.
+ */
+
+typedef uint32_t systime_t;
+
+#define CH_FREQUENCY 1000
+
+#define MS2ST(msec)                                                         \
+  ((systime_t)(((((uint32_t)(msec)) * ((uint32_t)CH_FREQUENCY) - 1UL) /     \
+                1000UL) + 1UL))
+
+extern systime_t host_system_time;
+
+inline systime_t chTimeNow() {
+	return host_system_time;
+}
+
+#endif/*_CH_H_*/
@@ -0,0 +1,73 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __M0_HOST_H__
+#define __M0_HOST_H__
+
+#include <cstdint>
+
+/* Forced into application sources built for the host tests, in place of
+ * headers that need the target. Their include guards are taken here, so the
+ * real ones (found next to the sources that include them) come out empty.
+ */
+
+// lpc43xx_cpp.hpp: only the RTC time, built the same way
+#define __LPC43XX_CPP_H__
+
+namespace lpc43xx {
+namespace rtc {
+
+struct RTC {
+	uint32_t tv_date { 0 };
+	uint32_t tv_time { 0 };
+
+	constexpr RTC(
+		uint32_t year,
+		uint32_t month,
+		uint32_t day,
+		uint32_t hour,
+		uint32_t minute,
+		uint32_t second
+	) : tv_date { (year << 16) | (month << 8) | (day << 0) },
+		tv_time { (hour << 16) | (minute << 8) | (second << 0) }
+	{
+	}
+
+	constexpr RTC() = default;
+
+	uint16_t year() const { return (tv_date >> 16) & 0xfff; }
+	uint8_t month() const { return (tv_date >> 8) & 0x00f; }
+	uint8_t day() const { return (tv_date >> 0) & 0x01f; }
+	uint8_t hour() const { return (tv_time >> 16) & 0x01f; }
+	uint8_t minute() const { return (tv_time >> 8) & 0x03f; }
+	uint8_t second() const { return (tv_time >> 0) & 0x03f; }
+};
+
+} /* namespace rtc */
+} /* namespace lpc43xx */
+
+// file.hpp: string_format only needs the FAT timestamp
+#define __FILE_H__
+
+struct FATTimestamp {
+	uint16_t FAT_date;
+	uint16_t FAT_time;
+};
+
+#endif/*__M0_HOST_H__*/
@@ -0,0 +1,44 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <cstdio>
+
+/* Minimal checks for the host tests: failures are printed and counted, the
+ * test's main() returns test_result().
+ */
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+	if( !(cond) ) { \
+		std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+		test_failures++; \
+	} \
+} while(0)
+
+static inline int test_result() {
+	if( test_failures ) {
+		std::printf("%d check(s) failed\n", test_failures);
+	}
+	return test_failures ? 1 : 0;
+}
+
+#endif/*__TEST_H__*/
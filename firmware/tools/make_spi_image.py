@@ -22,14 +22,23 @@
 #
 
 import sys
+import struct
 
 usage_message = """
 PortaPack SPI flash image generator
 
-Usage: <command> <application_path> <baseband_path> <output_path>
+Usage: <command> [--compress] <application_path> <baseband_path> <output_path>
        Where paths refer to the .bin files for each component project.
+       --compress stores baseband images as LZ4 blocks where that saves space.
 """
 
+chunk_header_format = '<4sI'
+chunk_header_size = struct.calcsize(chunk_header_format)
+chunk_flag_compressed = 0x80000000
+compressed_header_format = '<II'
+directory_tag = b'PDIR'
+directory_entry_format = '<4sI'
+
 def read_image(path):
 	f = open(path, 'rb')
 	data = f.read()
@@ -41,13 +50,103 @@ def write_image(data, path):
 	f.write(data)
 	f.close()
 
-if len(sys.argv) != 4:
+def lz4_length(out, value):
+	while value >= 255:
+		out.append(255)
+		value -= 255
+	out.append(value)
+
+def lz4_sequence(out, literals, offset, match_length):
+	token = min(len(literals), 15) << 4
+	if match_length:
+		token |= min(match_length - 4, 15)
+	out.append(token)
+	if len(literals) >= 15:
+		lz4_length(out, len(literals) - 15)
+	out += literals
+	if match_length:
+		out += struct.pack('<H', offset)
+		if match_length - 4 >= 15:
+			lz4_length(out, match_length - 4 - 15)
+
+def lz4_compress_block(data):
+	# Greedy LZ4 block encoder. Per the block format rules, the last match
+	# starts at least 12 bytes before the end and the last 5 bytes are literals.
+	data = bytearray(data)
+	out = bytearray()
+	table = {}
+	anchor = 0
+	i = 0
+	match_limit = len(data) - 12
+	while i < match_limit:
+		key = bytes(data[i:i + 4])
+		candidate = table.get(key)
+		table[key] = i
+		if candidate is None or (i - candidate) > 65535:
+			i += 1
+			continue
+		length = 4
+		length_limit = len(data) - 5 - i
+		while length < length_limit and data[candidate + length] == data[i + length]:
+			length += 1
+		lz4_sequence(out, data[anchor:i], i - candidate, length)
+		i += length
+		anchor = i
+	lz4_sequence(out, data[anchor:], 0, 0)
+	return out
+
+def read_chunks(data):
+	chunks = []
+	offset = 0
+	while True:
+		tag, length = struct.unpack_from(chunk_header_format, data, offset)
+		if tag == b'\0\0\0\0':
+			return chunks
+		offset += chunk_header_size
+		chunks.append((tag, data[offset:offset + length]))
+		offset += length
+
+def make_chunk(tag, data, compress):
+	length = len(data)
+	if compress and length > 0:
+		block = lz4_compress_block(data)
+		packed = struct.pack(compressed_header_format, length, len(block)) + block
+		# Keep chunk headers word aligned, the M0 can't do unaligned loads
+		packed += bytearray(-len(packed) & 3)
+		if len(packed) < length:
+			data = packed
+			length = len(packed) | chunk_flag_compressed
+	return struct.pack(chunk_header_format, tag, length) + data
+
+def make_images(data, compress):
+	chunks = [make_chunk(tag, image, compress) for tag, image in read_chunks(data)]
+
+	# Directory chunk comes first, offsets are from the start of the directory
+	directory_size = chunk_header_size + struct.calcsize(directory_entry_format) * len(chunks)
+	directory = bytearray()
+	images = bytearray()
+	for chunk in chunks:
+		directory += struct.pack(directory_entry_format, chunk[0:4], directory_size + len(images))
+		images += chunk
+
+	output = bytearray()
+	output += struct.pack(chunk_header_format, directory_tag, len(directory)) + directory
+	output += images
+	output += struct.pack(chunk_header_format, b'\0\0\0\0', 0)
+	return output
+
+args = sys.argv[1:]
+compress = '--compress' in args
+if compress:
+	args.remove('--compress')
+
+if len(args) != 3:
 	print(usage_message)
 	sys.exit(-1)
 
-application_image = read_image(sys.argv[1])
-baseband_image = read_image(sys.argv[2])
-output_path = sys.argv[3]
+application_image = read_image(args[0])
+baseband_image = make_images(read_image(args[1]), compress)
+output_path = args[2]
 
 spi_size = 1048576
 